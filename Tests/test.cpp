@@ -1,19 +1,28 @@
 #include <any>
+#include <random>
+#include <list>
 #include <array>
+#include <fstream>
+#include <cstdint>
 #include <string>
 #include <cassert>
 #include <cstddef>
 #include <functional>
+#include <filesystem>
 #include <forward_list>
+#include <memory_resource>
 #include <unordered_map>
 
 #include <ltl/algos.h>
+#include <ltl/mmap.h>
 #include <ltl/stream.h>
 #include <ltl/traits.h>
 #include <ltl/thread.h>
 #include <ltl/optional.h>
+#include <ltl/serialize.h>
 #include <ltl/operator.h>
 #include <ltl/expected.h>
+#include <ltl/movable_any.h>
 #include <ltl/condition.h>
 #include <ltl/immutable.h>
 #include <ltl/Range/seq.h>
@@ -27,7 +36,9 @@
 #include <ltl/optional_type.h>
 #include <ltl/Range/actions.h>
 #include <ltl/Range/Repeater.h>
+#include <ltl/Range/SplitView.h>
 #include <ltl/Range/enumerate.h>
+#include <ltl/Range/generator.h>
 #include <ltl/Range/DefaultView.h>
 #include <gtest/gtest.h>
 
@@ -639,6 +650,51 @@ TEST(LTL_test, test_algos) {
     }
 }
 
+template <typename T>
+static void check_simd_search(std::size_t n) {
+    std::vector<T> values(n);
+    for (std::size_t i = 0; i < n; ++i)
+        values[i] = static_cast<T>(i % 7);
+    for (int x = -1; x < 9; ++x) {
+        ASSERT_EQ(ltl::find(values, x), std::find(values.begin(), values.end(), x));
+        ASSERT_EQ(ltl::count(values, x), std::count(values.begin(), values.end(), x));
+    }
+    if (n > 0) {
+        values.back() = T(42);
+        ASSERT_EQ(ltl::index_of(values, 42), n - 1);
+        ASSERT_TRUE(ltl::contains(values, T(42)));
+#if LTL_SIMD_RUNTIME_DISPATCH
+        if constexpr (sizeof(T) > 1) {
+            const T *p = values.data();
+            ASSERT_EQ(ltl::details::find_sse2(p, p + n, T(42)), p + n - 1);
+        }
+        ASSERT_EQ(ltl::details::count_sse2(values.data(), values.data() + n, T(3)),
+                  std::size_t(std::count(values.begin(), values.end(), T(3))));
+#endif
+    }
+}
+
+TEST(LTL_test, test_simd_search) {
+    for (std::size_t n : {0, 1, 15, 16, 17, 33, 64, 100, 1000}) {
+        check_simd_search<std::uint8_t>(n);
+        check_simd_search<std::int16_t>(n);
+        check_simd_search<std::uint32_t>(n);
+        check_simd_search<std::int64_t>(n);
+    }
+
+    std::vector<std::uint32_t> ids = {1, 2, 0xFFFFFFFF, 3};
+    ASSERT_EQ(ltl::index_of(ids, -1), 2);
+    std::vector<std::uint8_t> bytes = {0, 1, 255};
+    ASSERT_FALSE(ltl::contains(bytes, 256));
+    ASSERT_EQ(ltl::find_ptr(bytes, 255), &bytes[2]);
+
+    std::string text = "The quick brown fox jumps over the lazy dog";
+    ASSERT_EQ(ltl::index_of(text, 'z'), 37);
+    ASSERT_EQ(ltl::count(text, 'o'), 4);
+    ASSERT_EQ(ltl::find_value(text, 'q'), 'q');
+    ASSERT_EQ(text | ltl::actions::find('x'), text.begin() + 18);
+}
+
 TEST(LTL_test, test_find_range) {
     const std::array v = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
 
@@ -756,6 +812,80 @@ TEST(LTL_test, test_filter) {
     ASSERT_TRUE((min - (-2)) == max);
 }
 
+TEST(LTL_test, test_select) {
+    using namespace ltl;
+    std::vector<int> array = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    auto isOdd = _((x), x % 2);
+
+    auto odds = array | select(isOdd);
+    static_assert(std::is_same_v<decltype(odds.begin())::iterator_category, std::random_access_iterator_tag>);
+    ASSERT_EQ(odds.size(), 6);
+    ASSERT_EQ(odds.front(), 1);
+    ASSERT_EQ(odds.back(), 11);
+    ASSERT_EQ(odds[2], 5);
+    ASSERT_EQ(&odds[3], &array[7]);
+    ASSERT_EQ(odds.end() - odds.begin(), 6);
+    ASSERT_TRUE(ltl::equal(odds, array | filter(isOdd)));
+    ASSERT_TRUE(ltl::equal(odds | map([](int x) { return x * 2; }), std::array{2, 6, 10, 14, 18, 22}));
+    ASSERT_EQ((odds | chunks(4)).size(), 2);
+    ASSERT_EQ(odds | par | actions::sum, 36);
+
+    auto bigOdds = std::vector<int>{1, 2, 7, 9, 10} | select(isOdd, [](bool x) { return x; });
+    ASSERT_TRUE(ltl::equal(bigOdds, std::array{1, 7, 9}));
+
+    std::list<int> list = {1, 2, 3, 4, 5};
+    auto listOdds = list | select(isOdd);
+    ASSERT_EQ(listOdds.size(), 3);
+    ASSERT_EQ(listOdds.back(), 5);
+    ASSERT_TRUE(ltl::equal(listOdds | reversed, std::array{5, 3, 1}));
+
+    std::vector<int> empty;
+    ASSERT_TRUE((empty | select(isOdd)).empty());
+
+    // Adapted sources: sized ones are indexed, the others keep their iterators
+    auto times3 = array | map([](int x) { return x * 3; }) | select(isOdd);
+    ASSERT_TRUE(ltl::equal(times3, std::array{3, 9, 15, 21, 27, 33}));
+    ASSERT_EQ(times3[2], 15);
+    ASSERT_TRUE(ltl::equal(array | reversed | select(isOdd), std::array{11, 9, 7, 5, 3, 1}));
+    ASSERT_EQ(&(array | reversed | select(isOdd))[1], &array[9]);
+
+    std::vector<int> other = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+    auto sums = ltl::zip(array, other) | map([](auto t) {
+                    auto [x, y] = t;
+                    return x + y;
+                }) |
+                select(isOdd);
+    ASSERT_TRUE(ltl::equal(sums, std::array{1, 3, 5, 7, 9, 11, 13}));
+
+    auto bigFilteredOdds = array | filter([](int x) { return x > 4; }) | select(isOdd);
+    ASSERT_EQ(bigFilteredOdds.size(), 4);
+    ASSERT_EQ(bigFilteredOdds[0], 5);
+    ASSERT_EQ(&bigFilteredOdds.back(), &array[11]);
+}
+
+TEST(LTL_test, test_filter_is_walked_once) {
+    using namespace ltl;
+    std::size_t calls = 0;
+    auto isEven = [&calls](int x) {
+        ++calls;
+        return x % 2 == 0;
+    };
+
+    std::vector<int> values(100000);
+    std::iota(values.begin(), values.end(), 0);
+    ASSERT_TRUE(ltl::equal(values | filter(isEven) | take_n(3), std::array{0, 2, 4}));
+    ASSERT_LT(calls, 100u);
+
+    // A filter is not sized: every chunk is found by walking it, not by computing the distance to the end
+    calls = 0;
+    values.resize(20000);
+    std::size_t count = 0;
+    for (auto chunk : values | filter(isEven) | chunks(100))
+        count += chunk.size();
+    ASSERT_EQ(count, 10000u);
+    ASSERT_LT(calls, 100000u);
+}
+
 TEST(LTL_test, test_map) {
     using namespace ltl;
     std::array times2Array = {0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24};
@@ -816,6 +946,21 @@ TEST(LTL_test, test_to) {
     typed_static_assert(type_v<std::vector<std::string>> == type_from(oddTimes2Vector));
     typed_static_assert(type_v<std::deque<std::string>> == type_from(oddTimes2Deque));
     typed_static_assert(type_v<std::list<std::string>> == type_from(oddTimes2List));
+
+    auto oddTimes2Vector3 = oddTimes2 | map(_((x), std::to_string(x))) | to<std::vector>();
+    auto oddTimes2Deque3 = oddTimes2 | to<std::deque<long>>();
+    typed_static_assert(type_v<std::vector<std::string>> == type_from(oddTimes2Vector3));
+    typed_static_assert(type_v<std::deque<long>> == type_from(oddTimes2Deque3));
+    ASSERT_TRUE(ltl::equal(oddTimes2Vector3, strs));
+    ASSERT_TRUE(ltl::equal(oddTimes2Deque3, oddTimes2Array));
+
+    // The filters reserve the size of their source, and give back what they do not use
+    std::vector<int> all = array | filter(_((x), x >= 0)) | map(_((x), x * 2));
+    ASSERT_EQ(all.size(), array.size());
+    ASSERT_EQ(all.capacity(), array.size());
+    std::vector<int> few = array | filter(_((x), x < 2));
+    ASSERT_EQ(few, (std::vector<int>{0, 1}));
+    ASSERT_LT(few.capacity(), array.size());
 }
 
 TEST(LTL_test, test_integer_list) {
@@ -853,6 +998,41 @@ TEST(LTL_test, test_zip) {
     ASSERT_TRUE(ltl::equal(strings, std::array{"1"s, "2"s, "3"s, "4"s, "5"s}));
 }
 
+TEST(LTL_test, test_zip_random_access) {
+    std::vector<int> xs = {1, 2, 3, 4, 5};
+    std::vector<int> ys = {10, 20, 30};
+    std::list<int> list = {1, 2, 3, 4};
+
+    auto zipped = ltl::zip(xs, ys);
+    static_assert(ltl::IsSizedIterator<decltype(zipped.begin())>);
+    static_assert(!ltl::IsSizedIterator<decltype(ltl::zip(xs, list).begin())>);
+    static_assert(ltl::details::IsPushable<decltype(zipped.begin())>);
+
+    // The end comes from the shortest container
+    ASSERT_EQ(zipped.end() - zipped.begin(), 3u);
+    ASSERT_TRUE(zipped.end() == zipped.begin() + 3);
+    auto it = zipped.begin();
+    it += 2;
+    ASSERT_EQ(std::get<0>(*it), 3);
+    it -= 1;
+    ASSERT_EQ(std::get<1>(*it), 20);
+    ASSERT_EQ(std::get<1>(zipped.begin()[2]), 30);
+    ASSERT_EQ(std::get<0>(zipped.back()), 3);
+    ASSERT_EQ(std::get<0>(ltl::zip(xs, list).back()), 4);
+
+    auto products = zipped | ltl::map([](auto t) {
+                        auto [x, y] = t;
+                        return x * y;
+                    });
+    ASSERT_EQ(products | ltl::actions::sum, 140);
+    ASSERT_EQ(ltl::zip(xs, list) | ltl::map([](auto t) {
+                  auto [x, y] = t;
+                  return x + y;
+              }) | ltl::actions::sum,
+              20);
+    ASSERT_TRUE(ltl::equal(products, std::array{10, 40, 90}));
+}
+
 TEST(LTL_test, test_default_view) {
     using namespace std::literals;
     std::array<std::optional<int>, 5> array{};
@@ -920,6 +1100,46 @@ TEST(LTL_test, test_variant_utils) {
         typed_static_assert(ltl::is_callable_from(ok4, std::move(variant)));
         typed_static_assert(ltl::is_callable_from(bad1, std::move(variant)));
     }
+
+    {
+        // More alternatives than a block of the switch
+        using Large = std::variant<char, short, int, long, long long, unsigned char, unsigned short, unsigned int,
+                                   unsigned long, unsigned long long, float, double, long double, bool, std::nullptr_t,
+                                   std::vector<int>, std::string, std::unique_ptr<int>>;
+        auto name = ltl::overloader{[](const std::string &s) { return s; }, [](const auto &) { return std::string{}; },
+                                    [](const std::unique_ptr<int> &p) { return std::to_string(*p); }};
+        Large large = std::string{"string"};
+        ASSERT_EQ(ltl::visit(name, large), "string");
+        large = std::make_unique<int>(17);
+        ASSERT_EQ(ltl::visit(name, large), "17");
+        large = 'a';
+        ASSERT_EQ(ltl::visit(name, large), "");
+
+        auto moved = ltl::visit(ltl::overloader{[](std::unique_ptr<int> &&p) { return std::move(p); },
+                                                [](auto &&) { return std::unique_ptr<int>{}; }},
+                                Large{std::make_unique<int>(3)});
+        ASSERT_EQ(*moved, 3);
+
+        // The references are forwarded
+        std::variant<int, double> a = 1;
+        int &reference = ltl::visit(ltl::overloader{[](int &x) -> int & { return x; },
+                                                    [](double &) -> int & { throw std::logic_error{"double"}; }},
+                                    a);
+        reference = 7;
+        ASSERT_EQ(std::get<int>(a), 7);
+
+        std::variant<int, std::string> b = std::string{"abc"};
+        auto sum = [](auto x, const auto &y) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(y)>, std::string>)
+                return double(x) + y.size();
+            else
+                return double(x) + y;
+        };
+        ASSERT_EQ(ltl::visit(sum, a, b), 10.0);
+        a = 0.5;
+        b = 2;
+        ASSERT_EQ(ltl::visit(sum, a, b), 2.5);
+    }
 }
 
 TEST(LTL_test, test_functional) {
@@ -1160,6 +1380,90 @@ TEST(LTL_test, test_join) {
 
         ASSERT_TRUE(ltl::equal(array2, std::array{0, 0, 0, 1, 1, 1, 2, 2, 2}));
     }
+
+    {
+        std::list<std::list<int>> lists = {{0, 1}, {}, {2, 3, 4}, {5}};
+        auto joined = lists | join;
+        ASSERT_EQ(std::addressof(*std::next(joined.begin(), 4)), std::addressof(std::next(lists.begin(), 2)->back()));
+        ASSERT_TRUE(ltl::equal(joined | ltl::reversed, std::array{5, 4, 3, 2, 1, 0}));
+        ASSERT_EQ(joined | actions::sum, 15);
+
+        // The containers given by value are shared by the copies of an iterator
+        std::array<int, 3> array = {1, 2, 3};
+        auto repeated = array >> map([](int x) { return std::vector<int>(x, x); });
+        auto it = repeated.begin();
+        auto copy = std::next(it, 2);
+        ++it;
+        ASSERT_EQ(*copy, 2);
+        ASSERT_TRUE(std::next(it) == copy);
+        ASSERT_TRUE(std::next(repeated.begin(), 2) == copy);
+        ASSERT_TRUE(ltl::equal(repeated, std::array{1, 2, 2, 3, 3, 3}));
+    }
+
+    {
+        // The inner contiguous containers are pushed as a whole to the actions
+        std::vector<std::vector<int>> buckets = {{1, 2}, {}, {3, 4, 5}, {6}};
+        auto joined = buckets | join;
+        static_assert(ltl::details::IsPushable<decltype(joined.begin())>);
+        ASSERT_EQ(joined | actions::sum, 21);
+        ASSERT_EQ(joined | actions::accumulate(1, std::multiplies<>{}), 720);
+        ASSERT_TRUE((joined | actions::find_if([](int x) { return x > 3; })) == std::next(joined.begin(), 3));
+        ASSERT_TRUE((joined | actions::find_if([](int x) { return x > 6; })) == joined.end());
+        ASSERT_EQ((Range{std::next(joined.begin()), std::next(joined.begin(), 4)} | actions::sum), 9);
+        ASSERT_EQ((Range{std::next(joined.begin(), 2), std::next(joined.begin(), 4)} | actions::sum), 7);
+        auto odds = buckets >> map([](const auto &v) { return v | filter([](int x) { return x % 2; }); });
+        ASSERT_EQ(odds | actions::sum, 9);
+    }
+}
+
+TEST(LTL_test, test_segmented_algorithms) {
+    using namespace ltl;
+    std::vector<std::vector<int>> buckets = {{1, 2}, {}, {3, 4, 5}, {6}};
+    auto joined = buckets | join;
+    static_assert(details::IsSegmentedIterator<decltype(joined.begin())>);
+
+    ASSERT_EQ(accumulate(joined, 0), 21);
+    ASSERT_EQ(accumulate(joined, 1, std::multiplies<>{}), 720);
+    ASSERT_EQ(count_if(joined, [](int x) { return x % 2 == 0; }), 3);
+    ASSERT_TRUE(find_if(joined, [](int x) { return x > 3; }) == std::next(joined.begin(), 3));
+    ASSERT_TRUE(find_if(joined, [](int x) { return x > 6; }) == joined.end());
+
+    std::vector<int> copied;
+    copy(joined, std::back_inserter(copied));
+    ASSERT_TRUE(equal(copied, std::array{1, 2, 3, 4, 5, 6}));
+
+    int total = 0;
+    for_each(joined, [&total](int x) { total += x; });
+    ASSERT_EQ(total, 21);
+
+    // The local ranges of a join of joins are segmented too
+    std::vector<std::vector<std::vector<int>>> nested = {{{1}, {2, 3}}, {}, {{4}}};
+    auto flat = nested | join | join;
+    ASSERT_EQ(accumulate(flat, 0), 10);
+    ASSERT_TRUE(find_if(flat, [](int x) { return x == 3; }) == std::next(flat.begin(), 2));
+    ASSERT_EQ(flat | actions::sum, 10);
+
+    // The floating point sum stays left to right across the segments
+    std::vector<std::vector<float>> floats = {{1e8f, 1, 1, 1, 1}, {-1e8f, 1}};
+    ASSERT_EQ(floats | join | actions::sum, 1.f);
+    ASSERT_EQ(floats | join | actions::sum, accumulate(floats | join, 0.f));
+
+    // The chunks are adjacent: their join is one segment of the source
+    std::vector<int> values = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    auto rejoined = values | chunks(3) | join;
+    ASSERT_EQ(accumulate(rejoined, 0), 45);
+    ASSERT_EQ(rejoined | actions::sum, 45);
+    ASSERT_EQ(count_if(rejoined, [](int x) { return x > 6; }), 3);
+    auto seven = find_if(rejoined, [](int x) { return x == 7; });
+    ASSERT_TRUE(seven == std::next(rejoined.begin(), 7));
+    ASSERT_EQ(*seven, 7);
+    ASSERT_EQ(*++seven, 8);
+    ASSERT_EQ((Range{std::next(rejoined.begin(), 2), std::next(rejoined.begin(), 8)} | actions::sum), 27);
+
+    std::string sentence = "a bc def";
+    std::string letters;
+    copy(sentence | split(' ') | join, std::back_inserter(letters));
+    ASSERT_EQ(letters, "abcdef");
 }
 
 TEST(LTL_test, test_and_or) {
@@ -1355,6 +1659,60 @@ TEST(LTL_test, simple_test_stream) {
     ASSERT_TRUE(another == " another"s);
 }
 
+TEST(LTL_test, stream_buffer_areas) {
+    ltl::writeonly_streambuf<std::vector<std::uint8_t>> writebuf;
+    std::ostream ostream(&writebuf);
+    std::string big(10000, 'x');
+    ostream << 'a';
+    ostream.write(big.data(), big.size());
+    ASSERT_EQ(writebuf.getContainer().size(), 10001);
+    ostream << "bc" << 42;
+    ASSERT_EQ(writebuf.getContainer().size(), 10005);
+    auto bytes = writebuf.takeContainer();
+    ASSERT_TRUE(writebuf.getContainer().empty());
+    ASSERT_EQ(bytes.front(), 'a');
+    ASSERT_EQ(std::string(bytes.end() - 4, bytes.end()), "bc42");
+
+    // getContainer shows what was written before the call, without the unused capacity
+    const auto &constWritebuf = writebuf;
+    ostream << "d";
+    ASSERT_EQ(constWritebuf.getContainer().size(), 1u);
+    ostream.write(big.data(), 100);
+    ostream << 'e';
+    ASSERT_EQ(constWritebuf.getContainer().size(), 102u);
+    ASSERT_EQ(constWritebuf.getContainer().back(), 'e');
+    ostream << 'f';
+    ASSERT_EQ(writebuf.takeContainer().size(), 103u);
+
+    ltl::readonly_streambuf<std::vector<std::uint8_t>> readbuf{std::move(bytes)};
+    std::istream istream(&readbuf);
+    ASSERT_EQ(istream.get(), 'a');
+    ASSERT_EQ(readbuf.in_avail(), 10004);
+    std::string read(10002, '\0');
+    istream.read(read.data(), read.size());
+    ASSERT_TRUE(istream);
+    ASSERT_EQ(read, big + "bc");
+    istream.unget();
+    ASSERT_EQ(istream.get(), 'c');
+
+    // A partial read gives the remaining characters
+    char tail[8] = {};
+    ASSERT_EQ(readbuf.sgetn(tail, 8), 2);
+    ASSERT_EQ(std::string(tail), "42");
+    ASSERT_EQ(istream.get(), std::char_traits<char>::eof());
+
+    readbuf.feed(std::string("de"));
+    istream.clear();
+    ASSERT_EQ(istream.get(), 'd');
+    istream.seekg(1);
+    ASSERT_EQ(istream.get(), 'x');
+
+    std::list<char> letters = {'f', 'g', 'h'};
+    ltl::readonly_streambuf<std::list<char>> listbuf{letters};
+    ASSERT_EQ(listbuf.sgetn(tail, 8), 3);
+    ASSERT_EQ(std::string(tail, 3), "fgh");
+}
+
 TEST(LTL_test, stream_test_message) {
     Message a;
     ltl::writeonly_streambuf<std::vector<char>> writebuf;
@@ -1420,6 +1778,241 @@ TEST(LTL_test, complexe_stream_test_message) {
     }
 }
 
+namespace any_test {
+inline int allocations = 0;
+
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() = default;
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U> &) noexcept {}
+
+    T *allocate(std::size_t n) {
+        ++allocations;
+        return std::allocator<T>{}.allocate(n);
+    }
+    void deallocate(T *p, std::size_t n) noexcept {
+        --allocations;
+        std::allocator<T>{}.deallocate(p, n);
+    }
+};
+} // namespace any_test
+
+TEST(LTL_test, test_unique_any) {
+    using any = ltl::unique_any<32, any_test::CountingAllocator<std::byte>>;
+    using big = std::array<int, 64>;
+
+    static_assert(!std::is_copy_constructible_v<any>);
+    static_assert(std::is_nothrow_move_constructible_v<any>);
+    static_assert(any::stores_inline<int>() && any::stores_inline<std::string>());
+    static_assert(!any::stores_inline<big>());
+
+    auto counter = std::make_shared<int>(0);
+    {
+        std::vector<any> values;
+        values.emplace_back(5);
+        values.emplace_back(std::string{"a string"});
+        values.emplace_back(counter);
+        values.emplace_back(big{1, 2, 3});
+        ASSERT_EQ(any_test::allocations, 1);
+        ASSERT_EQ(counter.use_count(), 2);
+
+        // Growing the vector moves every value
+        values.reserve(100);
+        ASSERT_EQ(values[0].get<int>(), 5);
+        ASSERT_EQ(values[1].get<std::string>(), "a string");
+        ASSERT_EQ(values[2].get<std::shared_ptr<int>>(), counter);
+        ASSERT_EQ(values[3].get<big>()[2], 3);
+        ASSERT_TRUE(values[1].type() == typeid(std::string));
+        ASSERT_EQ(any_test::allocations, 1);
+        ASSERT_EQ(counter.use_count(), 2);
+
+        any moved = std::move(values[3]);
+        ASSERT_FALSE(values[3].has_value());
+        ASSERT_TRUE(values[3].type() == typeid(void));
+        ASSERT_EQ(moved.get<big>()[1], 2);
+
+        moved = std::move(values[2]);
+        ASSERT_EQ(any_test::allocations, 0);
+        ASSERT_EQ(counter.use_count(), 2);
+
+        moved.emplace<std::string>(3, 'x');
+        ASSERT_EQ(moved.get<std::string>(), "xxx");
+        ASSERT_EQ(counter.use_count(), 1);
+    }
+    ASSERT_EQ(any_test::allocations, 0);
+}
+
+TEST(LTL_test, test_serialize) {
+    using Id = ltl::strong_type_t<std::uint32_t, struct SerializedIdTag>;
+    using Payload = std::variant<std::monostate, std::string, std::vector<Float>>;
+    using Record =
+        ltl::tuple_t<Id, ltl::varint<std::int64_t>, std::vector<double>, Payload, std::array<short, 3>, bool>;
+
+    Record record{Id{7u},
+                  {-3},
+                  std::vector<double>{1.5, 2.5, 3.5},
+                  Payload{std::vector<Float>{Float{1.0f}, Float{2.0f}}},
+                  std::array<short, 3>{1, 2, 3},
+                  true};
+    auto bytes = ltl::serialize(record);
+    // 4 + 1 + (1 + 24) + (1 + 1 + 8) + 6 + 1
+    ASSERT_EQ(bytes.size(), 47);
+    ASSERT_EQ(bytes.size(), ltl::serialized_size(record));
+    ASSERT_EQ(bytes[0], 7);
+    ASSERT_EQ(bytes[4], 5); // zigzag
+
+    auto decoded = ltl::deserialize<Record>(bytes);
+    static_assert(std::is_same_v<decltype(decoded), ltl::optional<Record>>);
+    ASSERT_TRUE(decoded);
+    ASSERT_EQ(decoded | ltl::map([](const Record &r) { return r.get<0>().get(); }), 7);
+    ASSERT_EQ(decoded->get<0>().get(), 7);
+    ASSERT_EQ(decoded->get<1>(), ltl::varint<std::int64_t>{-3});
+    ASSERT_EQ(decoded->get<2>(), (std::vector<double>{1.5, 2.5, 3.5}));
+    ASSERT_TRUE((std::get<2>(decoded->get<3>()) == std::vector<Float>{Float{1.0f}, Float{2.0f}}));
+    ASSERT_EQ(decoded->get<4>(), (std::array<short, 3>{1, 2, 3}));
+    ASSERT_TRUE(decoded->get<5>());
+
+    // Truncated or trailing bytes
+    for (std::size_t n = 0; n < bytes.size(); ++n)
+        ASSERT_FALSE(ltl::deserialize<Record>(std::vector<std::uint8_t>(bytes.begin(), bytes.begin() + n)));
+    bytes.push_back(0);
+    ASSERT_FALSE(ltl::deserialize<Record>(bytes));
+
+    ltl::TypedTuple<std::string, ltl::varint<std::uint64_t>> typed{"name"s, {300}};
+    std::vector<std::uint8_t> buffer(ltl::serialized_size(typed) + 1);
+    ASSERT_EQ(ltl::serialize(typed, buffer.data()), buffer.data() + 7);
+    ASSERT_EQ(buffer[5], 0xAC);
+    ASSERT_EQ(buffer[6], 0x02);
+
+    decltype(typed) decodedTyped;
+    ASSERT_EQ(ltl::deserialize(decodedTyped, buffer.data(), buffer.data() + buffer.size()), buffer.data() + 7);
+    ASSERT_EQ(decodedTyped.get<std::string>(), "name");
+    ASSERT_EQ(decodedTyped.get<ltl::varint<std::uint64_t>>().value, 300);
+
+    // A corrupted size or variant index
+    ASSERT_FALSE(ltl::deserialize<std::string>(std::vector<std::uint8_t>{0xFF, 0xFF, 0xFF, 0x0F, 'a'}));
+    ASSERT_FALSE(ltl::deserialize<Payload>(std::vector<std::uint8_t>{3}));
+
+    for (std::int32_t x : {0, 1, -1, 63, -64, 64, std::numeric_limits<std::int32_t>::min(),
+                           std::numeric_limits<std::int32_t>::max()}) {
+        auto varintBytes = ltl::serialize(ltl::varint{x});
+        ASSERT_EQ(ltl::deserialize<ltl::varint<std::int32_t>>(varintBytes)->value, x);
+    }
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST(LTL_test, test_mmap_range) {
+    struct Record {
+        std::uint32_t id;
+        float value;
+    };
+
+    // The C++17 and C++20 test binaries may run at the same time, so every process gets its own file
+    const auto fileName = "ltl_test_mmap_range_" + std::to_string(::getpid()) + ".bin";
+    const auto path = (std::filesystem::temp_directory_path() / fileName).string();
+    {
+        std::ofstream file{path, std::ios::binary};
+        for (std::uint32_t i = 0; i < 1000; ++i) {
+            Record record{i, i / 2.0f};
+            file.write(reinterpret_cast<const char *>(&record), sizeof(record));
+        }
+        file.write("tail", 3);
+    }
+
+    {
+        auto records = ltl::make_mmap_range<Record>(path, ltl::mmap_advice::sequential);
+        ASSERT_TRUE(records);
+        const auto &range = records.result();
+        ASSERT_EQ(range.size(), 1000);
+        ASSERT_EQ(range[999].id, 999);
+        ASSERT_EQ(range | ltl::map(&Record::id) | ltl::actions::accumulate(std::uint64_t{0}), 999 * 1000 / 2);
+        ASSERT_EQ((range | ltl::chunks(300)).size(), 4);
+        ASSERT_FALSE(range.advise(ltl::mmap_advice::random));
+
+        auto moved = std::move(records).result();
+        ASSERT_EQ(moved.size(), 1000);
+        ASSERT_EQ(ltl::make_mmap_range(path).result().size(), 1000 * sizeof(Record) + 3);
+    }
+
+    {
+        std::ofstream{path} << "first line\nsecond line\n";
+        auto text = ltl::make_mmap_range(path);
+        ASSERT_TRUE(ltl::equal(text.result() | ltl::split_view('\n'), std::array{"first line"sv, "second line"sv}));
+    }
+
+    std::ofstream{path};
+    ASSERT_TRUE(ltl::make_mmap_range<Record>(path).result().empty());
+
+    std::filesystem::remove(path);
+    auto missing = ltl::make_mmap_range(path);
+    ASSERT_FALSE(missing);
+    ASSERT_EQ(missing.error(), std::errc::no_such_file_or_directory);
+}
+#endif
+
+TEST(LTL_test, ring_streambuf) {
+    {
+        auto msgs = detail::createMessages();
+        auto buffer = detail::createComplexeBuffer();
+        std::vector<Message> decodedMsgs;
+        ltl::ring_streambuf ring{1000};
+        ASSERT_EQ(ring.capacity(), 1024);
+        std::istream stream(&ring);
+
+        for (std::uint32_t i = 0; i < buffer.size(); i += 73) {
+            ASSERT_EQ(ring.feed(ltl::Range{buffer.begin() + i, buffer.end()} | ltl::take_n(73)),
+                      std::min<std::size_t>(73, buffer.size() - i));
+            std::copy(std::istream_iterator<Message>(stream), std::istream_iterator<Message>{},
+                      std::back_inserter(decodedMsgs));
+            stream.clear();
+        }
+        ASSERT_TRUE(ltl::equal(msgs, decodedMsgs));
+    }
+
+    {
+        ltl::ring_streambuf ring{8};
+        std::istream stream(&ring);
+        ASSERT_EQ(ring.feed("0123456789"s), 8);
+        ASSERT_EQ(ring.prepare().size(), 0);
+
+        char read[6] = {};
+        stream.read(read, 5);
+        ASSERT_EQ(std::string(read), "01234");
+        ASSERT_EQ(ring.prepare().size(), 0);
+        stream.seekg(1);
+        ASSERT_EQ(stream.get(), '1');
+        stream.seekg(2);
+        ring.pubsync();
+        ASSERT_EQ(stream.tellg(), 2);
+        stream.seekg(1);
+        ASSERT_FALSE(stream);
+        stream.clear();
+
+        // The free space wraps at the end of the ring
+        auto space = ring.prepare();
+        ASSERT_EQ(space.size(), 2);
+        std::copy_n("ab", 2, space.begin());
+        ring.commit(2);
+        ASSERT_EQ(ring.feed("cdef"s), 0);
+
+        std::string all;
+        stream >> all;
+        ASSERT_EQ(all, "234567ab");
+        ASSERT_EQ(stream.tellg(), -1);
+        stream.clear();
+        ASSERT_EQ(stream.tellg(), 10);
+        ring.pubsync();
+        ASSERT_EQ(ring.feed("cdefghijkl"s), 8);
+        stream.read(read, 5);
+        ASSERT_EQ(std::string(read), "cdefg");
+        stream.unget();
+        ASSERT_EQ(stream.get(), 'g');
+    }
+}
+
 TEST(LTL_test, test_variant_recursive) {
     using namespace ltl;
 
@@ -1452,6 +2045,39 @@ TEST(LTL_test, test_variant_recursive) {
         r);
 }
 
+namespace arena_test {
+using Expression = ltl::recursive_variant<int, std::string, ltl::arena_recursive_wrapper<struct Add>>;
+struct Add {
+    Expression lhs, rhs;
+};
+
+int evaluate(const Expression &expression) {
+    int result = 0;
+    recursive_visit(ltl::overloader{[&result](int x) { result = x; },
+                                    [&result](const std::string &x) { result = int(x.size()); },
+                                    [&result](const Add &add) { result = evaluate(add.lhs) + evaluate(add.rhs); }},
+                    expression);
+    return result;
+}
+} // namespace arena_test
+
+TEST(LTL_test, test_variant_recursive_arena) {
+    using namespace arena_test;
+    std::array<std::byte, 1024> buffer;
+    // The upstream resource fails: every node must fit in the buffer
+    std::pmr::monotonic_buffer_resource arena{buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+
+    Expression expression = 0;
+    {
+        ltl::arena_scope scope{arena};
+        expression = Add{1, Add{std::string{"a string longer than the small buffer"}, Add{2, 3}}};
+    }
+    ASSERT_EQ(evaluate(expression), 1 + 37 + 2 + 3);
+
+    Expression moved = std::move(expression);
+    ASSERT_EQ(evaluate(moved), 43);
+}
+
 TEST(LTL_test, test_typed_tuple) {
     ltl::TypedTuple<int, double, int *> tuple;
     static_assert(type_from(tuple.get<int>()) == ltl::type_v<int &>);
@@ -1656,6 +2282,87 @@ TEST(LTL_test, test_filter_composed) {
     ASSERT_TRUE(equal(result, std::array{4, 5, 6}));
 }
 
+TEST(LTL_test, test_fused_operations) {
+    using namespace ltl;
+    std::vector<int> array = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    auto is_odd = [](auto x) { return x % 2 == 1; };
+    auto sup_than4 = [](auto x) { return x > 4; };
+    auto square = [](auto x) { return x * x; };
+    auto plus_one = [](auto x) { return x + 1; };
+
+    using source_iterator = std::vector<int>::iterator;
+    auto filters = array | filter(is_odd) | filter(sup_than4);
+    static_assert(std::is_same_v<decltype(filters.begin().m_it), source_iterator>);
+    ASSERT_TRUE(equal(filters, std::array{5, 7, 9, 11}));
+    ASSERT_TRUE(equal(filters | reversed, std::array{11, 9, 7, 5}));
+
+    auto maps = array | map(square) | map(plus_one);
+    static_assert(std::is_same_v<decltype(maps.begin().m_it), source_iterator>);
+    ASSERT_EQ(maps.size(), array.size());
+    ASSERT_TRUE(equal(maps | take_n(4), std::array{1, 2, 5, 10}));
+
+    auto chain = array | map(plus_one) | filter(is_odd) | filter(sup_than4) | map(square);
+    static_assert(std::is_same_v<decltype(chain.begin().m_it.m_it), source_iterator>);
+    ASSERT_TRUE(equal(chain, std::array{25, 49, 81, 121}));
+
+    auto dropped = array | filter(is_odd) | drop_n(2) | filter(sup_than4);
+    ASSERT_TRUE(equal(dropped, std::array{5, 7, 9, 11}));
+    auto taken = array | filter(is_odd) | take_n(3) | filter(sup_than4);
+    ASSERT_TRUE(equal(taken, std::array{5}));
+}
+
+TEST(LTL_test, test_push_actions) {
+    using namespace ltl;
+    std::vector<int> array = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    std::list<int> list(array.begin(), array.end());
+    auto is_odd = [](auto x) { return x % 2 == 1; };
+    auto square = [](auto x) { return x * x; };
+
+    static_assert(ltl::details::IsPushable<decltype(begin(array | filter(is_odd) | map(square)))>);
+    static_assert(!ltl::details::IsPushable<decltype(begin(list | filter(is_odd) | map(square)))>);
+
+    ASSERT_EQ(array | filter(is_odd) | map(square) | actions::sum, 286);
+    ASSERT_EQ(list | filter(is_odd) | map(square) | actions::sum, 286);
+    ASSERT_EQ(array | filter(is_odd) | take_n(3) | actions::accumulate(100), 109);
+    ASSERT_EQ(array | map(square) | actions::accumulate(std::string{}, [](std::string s, int x) {
+                  return std::move(s) + std::to_string(x);
+              }),
+              "0149162536496481100121");
+
+    auto squares = array | filter(is_odd) | map(square);
+    auto it = squares | actions::find_if(greater_than(40));
+    ASSERT_EQ(*it, 49);
+    ASSERT_EQ(*++it, 81);
+    ASSERT_TRUE((squares | actions::find_if(greater_than(200))) == squares.end());
+    ASSERT_EQ(squares | actions::find_if_value(greater_than(100)), 121);
+    auto odds = array | filter(is_odd);
+    ASSERT_EQ(odds | actions::find_if_ptr(greater_than(6)), &array[7]);
+}
+
+TEST(LTL_test, test_simd_sum) {
+    using namespace ltl;
+    std::vector<int> ints(1001);
+    std::iota(ints.begin(), ints.end(), 1);
+    auto square = [](auto x) { return x * x; };
+
+    ASSERT_EQ(ints | actions::sum, 501501);
+    ASSERT_EQ(ints | map(square) | actions::sum, 334835501);
+    ASSERT_EQ(ints | actions::accumulate(1000LL), 502501LL);
+    ASSERT_EQ(std::vector<int>{} | actions::sum, 0);
+
+    std::vector<unsigned char> bytes(300, 1);
+    ASSERT_EQ(bytes | actions::sum, static_cast<unsigned char>(300));
+    ASSERT_EQ(bytes | actions::accumulate(0), 300);
+
+    std::vector<double> doubles(1001);
+    std::iota(doubles.begin(), doubles.end(), 0.5);
+    ASSERT_DOUBLE_EQ(doubles | actions::sum_fast, doubles | actions::sum);
+    ASSERT_DOUBLE_EQ(doubles | map(square) | actions::sum_fast, doubles | map(square) | actions::sum);
+
+    std::vector<std::string> strings = {"a", "b", "c"};
+    ASSERT_EQ(strings | actions::sum_fast, "abc");
+}
+
 TEST(LTL_test, test_remove_if) {
     using namespace ltl;
     std::array array = {0, 1, 2, 3, 4, 5, 6, 7};
@@ -1701,6 +2408,77 @@ TEST(LTL_test, test_expected) {
     }
 }
 
+namespace compact {
+enum class ParseError : std::uint8_t { none, invalid_character, too_long };
+} // namespace compact
+
+template <>
+struct ltl::niche<compact::ParseError> {
+    static constexpr compact::ParseError value = compact::ParseError::none;
+};
+
+TEST(LTL_test, test_expected_layout) {
+    using namespace ltl;
+    using compact::ParseError;
+
+    static_assert(std::is_trivially_copyable_v<expected<int, const char *>>);
+    static_assert(sizeof(expected<int, const char *>) == 2 * sizeof(void *));
+    static_assert(sizeof(expected<Ok, const char *>) == sizeof(const char *));
+    static_assert(sizeof(expected<int *, Ok>) > sizeof(int *));
+    static_assert(sizeof(expected<Ok, ParseError>) == sizeof(ParseError));
+    static_assert(!std::is_trivially_copyable_v<expected<int, std::string>>);
+
+    {
+        expected<Ok, ParseError> ok{Ok{}};
+        expected<Ok, ParseError> error{ParseError::too_long};
+        ASSERT_TRUE(ok.is_result());
+        ASSERT_TRUE(error.is_error());
+        ASSERT_EQ(error.error(), ParseError::too_long);
+        ASSERT_TRUE((ok == expected<Ok, ParseError>{Ok{}}));
+        ASSERT_FALSE(ok == error);
+
+        ok = error;
+        ASSERT_TRUE(ok.is_error());
+        ASSERT_EQ(ok.error(), ParseError::too_long);
+    }
+
+    {
+        int value = 5;
+        expected<int *, Ok> pointer{&value};
+        expected<int *, Ok> none{Ok{}};
+        ASSERT_TRUE(pointer);
+        ASSERT_EQ(*pointer.result(), 5);
+        ASSERT_TRUE(none.is_error());
+
+        auto doubled = pointer | map([](int *p) { return *p * 2; });
+        ASSERT_EQ(doubled.result(), 10);
+    }
+
+    {
+        expected<int *, Ok> null{nullptr};
+        ASSERT_TRUE(null.is_result());
+        ASSERT_EQ(null.result(), nullptr);
+
+        expected<Ok, const char *> ok{Ok{}};
+        ASSERT_TRUE(ok.is_result());
+        ok = expected<Ok, const char *>{"Error"};
+        ASSERT_TRUE(ok.is_error());
+        ASSERT_EQ(std::string{ok.error()}, "Error");
+    }
+
+    {
+        expected<int, const char *> res{3};
+        expected<int, const char *> err{"Error"};
+        ASSERT_EQ(res.result(), 3);
+        ASSERT_EQ(std::string{err.error()}, "Error");
+        ASSERT_TRUE((res == expected<int, const char *>{3}));
+        ASSERT_FALSE(res == err);
+
+        res = err;
+        ASSERT_TRUE(res.is_error());
+    }
+}
+
 TEST(LTL_test, test_expected_monade) {
     using namespace ltl;
     expected<int, const char *> res = 18;
@@ -1847,6 +2625,47 @@ TEST(LTL_test, test_reverse) {
     ASSERT_EQ((b | ltl::reversed).size(), 0);
 }
 
+TEST(LTL_test, test_sized_ranges) {
+    using namespace ltl;
+    std::vector<int> vector{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    std::list<int> list{0, 1, 2, 3};
+
+    auto reversedVector = vector | reversed;
+    static_assert(IsSizedIterator<decltype(reversedVector.begin())>);
+    static_assert(!IsSizedIterator<decltype((list | reversed).begin())>);
+    ASSERT_EQ(reversedVector.size(), 10u);
+    ASSERT_EQ(reversedVector[0], 9);
+    ASSERT_EQ(reversedVector[9], 0);
+    ASSERT_EQ(reversedVector.back(), 0);
+    ASSERT_EQ(std::next(reversedVector.begin(), 10), reversedVector.end());
+    ASSERT_EQ(std::next(reversedVector.end(), -3), std::next(reversedVector.begin(), 7));
+
+    auto twiceReversed = vector | reversed | map([](int x) { return x * 2; }) | reversed;
+    static_assert(IsSizedIterator<decltype(twiceReversed.begin())>);
+    ASSERT_EQ(twiceReversed.size(), 10u);
+    ASSERT_EQ(twiceReversed[3], 6);
+    ASSERT_EQ((vector | reversed | take_n(3)).size(), 3u);
+    ASSERT_EQ((vector | reversed | drop_n(3)).back(), 0);
+
+    auto chunked = vector | chunks(3);
+    static_assert(IsSizedIterator<decltype(chunked.begin())>);
+    ASSERT_EQ(chunked.size(), 4u);
+    ASSERT_EQ((vector | take_n(9) | chunks(3)).size(), 3u);
+    ASSERT_EQ(chunked.back().size(), 1u);
+    ASSERT_EQ((list | chunks(3)).size(), 2u);
+
+    ASSERT_EQ(zip(vector, list).size(), 4u);
+    ASSERT_EQ(enumerate(vector).size(), 10u);
+    ASSERT_EQ(std::get<1>(zip(vector, list).back()), 3);
+
+    auto odds = vector | filter([](int x) { return x % 2; });
+    auto oddsTimes2 = odds | map([](int x) { return x * 2; });
+    static_assert(!IsSizedIterator<decltype(odds.begin())>);
+    static_assert(!IsSizedIterator<decltype(oddsTimes2.begin())>);
+    ASSERT_EQ(odds.size(), 5u);
+    ASSERT_EQ(odds.back(), 9);
+}
+
 TEST(LTL_test, test_split) {
     auto to_view = [](auto &&r) { return std::string_view(&*r.begin(), r.size()); };
 
@@ -1896,6 +2715,60 @@ TEST(LTL_test, test_split) {
     }
 }
 
+template <typename Delimiter>
+static void check_subviews(const ltl::SplitViewRange<Delimiter> &view) {
+    std::vector<std::string_view> tokens = view;
+    for (std::size_t count = 1; count < 40; ++count) {
+        std::vector<std::string_view> fromSubviews;
+        for (const auto &subview : view.subviews(count))
+            fromSubviews.insert(fromSubviews.end(), subview.begin(), subview.end());
+        ASSERT_EQ(fromSubviews, tokens);
+    }
+}
+
+TEST(LTL_test, test_split_view) {
+    using tokens = std::vector<std::string_view>;
+    {
+        std::string empty;
+        ASSERT_TRUE((empty | ltl::split_view(' ')).empty());
+        std::string text = "My name is  Antoine";
+        ASSERT_EQ(tokens(text | ltl::split_view(' ')), (tokens{"My", "name", "is", "", "Antoine"}));
+        ASSERT_EQ(tokens(text | ltl::split_view(',')), tokens{text});
+        ASSERT_EQ(tokens(" a b "sv | ltl::split_view(' ')), (tokens{"", "a", "b"}));
+        auto to_view = [](auto &&r) { return std::string_view(&*r.begin(), r.size()); };
+        ASSERT_EQ(tokens(text | ltl::split_view(' ')), tokens(text | ltl::split(' ') | ltl::map(to_view)));
+    }
+
+    {
+        std::string text = "first\r\nsecond\r\n\r\nthird\n\r\n";
+        ASSERT_EQ(tokens(text | ltl::split_view("\r\n")), (tokens{"first", "second", "", "third\n"}));
+        ASSERT_EQ(tokens(text | ltl::split_view("")), tokens{text});
+        ASSERT_EQ(tokens("a---b"sv | ltl::split_view("--")), (tokens{"a", "-b"}));
+        ASSERT_EQ(tokens("key=value;key2=value2 key3"sv | ltl::split_view(ltl::delimiters("=; "))),
+                  (tokens{"key", "value", "key2", "value2", "key3"}));
+    }
+
+    {
+        std::mt19937 generator;
+        std::string text;
+        for (int i = 0; i < 5000; ++i)
+            text += "ab-,;\n"[generator() % 6];
+        check_subviews(text | ltl::split_view('\n'));
+        check_subviews(text | ltl::split_view("--"));
+        check_subviews(text | ltl::split_view(",;"));
+        check_subviews(text | ltl::split_view(ltl::delimiters(",;\n")));
+        check_subviews(text | ltl::split_view(ltl::delimiters("abcdefghijklmnopqrstuvwxyz-")));
+
+        ltl::thread_pool pool{3};
+        auto size = [](std::string_view token) { return token.size(); };
+        auto view = text | ltl::split_view(ltl::delimiters(",;"));
+        ASSERT_EQ(view | ltl::par(pool) | ltl::map(size) | ltl::actions::sum,
+                  view | ltl::map(size) | ltl::actions::sum);
+        auto one = [](std::string_view) { return std::size_t{1}; };
+        ASSERT_EQ(view | ltl::par(pool) | ltl::map(one) | ltl::actions::sum, view.size());
+    }
+}
+
 TEST(LTL_test, test_chunks) {
     std::vector<int> vect(20);
     ltl::iota(vect, 0);
@@ -2204,6 +3077,163 @@ TEST(LTL_test, test_accumulate) {
     ASSERT_EQ(result3, 0 + 1 + 2 + 3 + 4 + 5 + 6);
 }
 
+TEST(LTL_test, test_parallel_actions) {
+    using namespace ltl;
+    ltl::thread_pool pool{3};
+    std::vector<int> values(1000);
+    ltl::iota(values, 0);
+
+    auto is_odd = [](auto x) { return x % 2 == 1; };
+    auto square = [](auto x) { return x * x; };
+
+    ASSERT_EQ(values | par(pool) | actions::sum, values | actions::sum);
+    ASSERT_EQ(values | par(pool) | filter(is_odd) | map(square) | actions::sum,
+              values | filter(is_odd) | map(square) | actions::sum);
+    ASSERT_EQ(values | par | (map(square) | filter(is_odd)) | actions::accumulate(10),
+              values | map(square) | filter(is_odd) | actions::accumulate(10));
+    std::vector<int> empty;
+    ASSERT_EQ(empty | par(pool) | actions::sum, 0);
+
+    // The elements do not need to be of the type of the result
+    std::vector<std::uint8_t> bytes(10000, 255);
+    ASSERT_EQ(bytes | par(pool) | actions::accumulate(std::size_t{1}), 2550001u);
+
+    // Any associative operation is accepted, the order of the elements is kept
+    auto max = [](int a, int b) { return std::max(a, b); };
+    ASSERT_EQ(values | par(pool) | map(square) | actions::accumulate(-1, max), 999 * 999);
+    ASSERT_EQ(empty | par(pool) | actions::accumulate(-1, max), -1);
+    auto digit = [](int x) { return std::string(1, static_cast<char>('0' + x % 10)); };
+    ASSERT_EQ(values | par(pool) | map(digit) | actions::accumulate(std::string{">"}, std::plus<>{}),
+              values | map(digit) | actions::accumulate(std::string{">"}, std::plus<>{}));
+
+    // The chunks are all done before the exception of one of them is propagated
+    std::string captured = "value";
+    auto throwing = [captured](int x) {
+        if (x == 0 || x == 999)
+            throw std::runtime_error{captured};
+        return x * static_cast<int>(captured.size());
+    };
+    ASSERT_THROW(values | par(pool) | map(throwing) | actions::sum, std::runtime_error);
+
+    std::vector<int> shuffled = values;
+    std::mt19937 generator;
+    std::shuffle(shuffled.begin(), shuffled.end(), generator);
+    shuffled |= par(pool) | actions::sort;
+    ASSERT_EQ(shuffled, values);
+
+    shuffled |= par(pool) | actions::sort_by_descending();
+    ASSERT_TRUE(ltl::equal(shuffled, values | reversed));
+}
+
+template <typename T>
+static void check_radix_sort(ltl::thread_pool &pool, std::size_t n) {
+    std::mt19937_64 generator{n};
+    std::vector<T> values(n);
+    for (auto &value : values)
+        value = static_cast<T>(static_cast<std::int64_t>(generator()) / 3);
+    auto expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    auto sorted = values | ltl::actions::sort;
+    ASSERT_EQ(sorted, expected);
+    values |= ltl::par(pool) | ltl::actions::sort;
+    ASSERT_EQ(values, expected);
+
+    // Few different bytes in the keys: the radix sort is always worth it
+    for (auto &value : values)
+        value = static_cast<T>(generator() % 50000);
+    expected = values;
+    std::sort(expected.begin(), expected.end());
+    auto parallel = values;
+    ASSERT_EQ(ltl::details::radix_sort(values.begin(), values.end(), ltl::identity), n >= 1024);
+    ASSERT_EQ(ltl::details::radix_sort(parallel.begin(), parallel.end(), ltl::identity, &pool), n >= 1024);
+    if (n >= 1024) {
+        ASSERT_EQ(values, expected);
+        ASSERT_EQ(parallel, expected);
+    }
+}
+
+TEST(LTL_test, test_radix_sort) {
+    using namespace ltl;
+    ltl::thread_pool pool{3};
+    for (std::size_t n : {0, 5, 1024, 5000}) {
+        check_radix_sort<std::int8_t>(pool, n);
+        check_radix_sort<int>(pool, n);
+        check_radix_sort<std::uint64_t>(pool, n);
+        check_radix_sort<float>(pool, n);
+        check_radix_sort<double>(pool, n);
+    }
+
+    std::vector<double> doubles = {1.5, -0.5, 3.0, -2.25, 0.0};
+    doubles.resize(2000, -1e10);
+    doubles |= actions::sort;
+    ASSERT_TRUE(std::is_sorted(doubles.begin(), doubles.end()));
+
+    struct Record {
+        std::uint64_t id;
+        std::size_t position;
+        std::string name;
+    };
+    std::vector<Record> records;
+    for (std::size_t i = 0; i < 3000; ++i)
+        records.push_back({(i * 7919) % 100, i, std::to_string(i)});
+
+    auto by_id = records | actions::sort_by_ascending(&Record::id);
+    auto id_then_position = [](const Record &a, const Record &b) {
+        return std::tie(a.id, a.position) < std::tie(b.id, b.position);
+    };
+    ASSERT_TRUE(std::is_sorted(by_id.begin(), by_id.end(), id_then_position));
+
+    records |= par(pool) | actions::sort_by_ascending(&Record::id);
+    ASSERT_TRUE(std::is_sorted(records.begin(), records.end(), id_then_position));
+
+    records |= par(pool) | actions::sort_by_ascending(&Record::name);
+    ASSERT_TRUE(std::is_sorted(records.begin(), records.end(), byAscending(&Record::name)));
+}
+
+template <std::size_t PayloadSize>
+static void check_radix_sort_records(ltl::thread_pool &pool) {
+    struct Record {
+        std::uint64_t key;
+        std::array<char, PayloadSize> payload;
+    };
+    // Three bytes of the keys differ
+    std::mt19937_64 generator{PayloadSize};
+    std::vector<Record> records(50000);
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        records[i].key = generator() % 2 ? generator() % (1 << 24) : 42;
+        records[i].payload.fill(static_cast<char>(i));
+    }
+    auto expected = records;
+    std::stable_sort(expected.begin(), expected.end(), [](const Record &a, const Record &b) { return a.key < b.key; });
+
+    auto key = &Record::key;
+    auto same = [](const Record &a, const Record &b) { return a.key == b.key && a.payload == b.payload; };
+    auto sorted = records;
+    ASSERT_TRUE(ltl::details::radix_sort(sorted.begin(), sorted.end(), key));
+    ASSERT_TRUE(std::equal(sorted.begin(), sorted.end(), expected.begin(), same));
+    ASSERT_TRUE(ltl::details::radix_sort(records.begin(), records.end(), key, &pool));
+    ASSERT_TRUE(std::equal(records.begin(), records.end(), expected.begin(), same));
+}
+
+TEST(LTL_test, test_radix_sort_records) {
+    using ltl::details::choose_radix_layout;
+    using ltl::details::radix_layout;
+    ltl::thread_pool pool{3};
+
+    // Sorted in place, and sorted through their keys and positions
+    static_assert(choose_radix_layout<16, 16>(50000, 3) == radix_layout::direct);
+    static_assert(choose_radix_layout<256, 16>(50000, 3) == radix_layout::indexed);
+    check_radix_sort_records<8>(pool);
+    check_radix_sort_records<248>(pool);
+
+    // Full 64 bits keys: large ranges take the radix sort, whatever the size of the records
+    static_assert(choose_radix_layout<16, 16>(200'000'000, 8) == radix_layout::direct);
+    static_assert(choose_radix_layout<128, 16>(200'000'000, 8) == radix_layout::indexed);
+    static_assert(choose_radix_layout<512, 16>(200'000'000, 8) == radix_layout::indexed);
+    static_assert(choose_radix_layout<16, 16>(100'000, 8) == radix_layout::none);
+}
+
 TEST(LTL_test, test_seq) {
     using namespace ltl;
     auto is_even = [](auto x) { return x % 2 == 0; };
@@ -2412,6 +3442,133 @@ TEST(LTL_test, test_mutex) {
     ASSERT_FALSE(value.with_lock(isConst));
 }
 
+template <typename Policy>
+static void checkMutexPolicy() {
+    struct Pair {
+        int a = 0;
+        int b = 0;
+    };
+    ltl::mutex<Pair, Policy, ltl::mutex_telemetry> pair;
+    std::atomic<bool> consistent{true};
+
+    auto write = [&pair] {
+        for (int i = 0; i < 1000; ++i)
+            pair.with_lock([](Pair &p) {
+                ++p.a;
+                ++p.b;
+            });
+    };
+    auto read = [&] {
+        for (int i = 0; i < 1000; ++i)
+            if (!std::as_const(pair).with_lock([](const Pair &p) { return p.a == p.b; }))
+                consistent = false;
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 2; ++i) {
+        threads.emplace_back(write);
+        threads.emplace_back(read);
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    ASSERT_TRUE(consistent);
+    ASSERT_EQ(std::as_const(pair).with_lock([](const Pair &p) { return p.a; }), 2000);
+
+    auto statistics = pair.telemetry().statistics();
+    ASSERT_EQ(statistics.acquisitions, 4001u);
+    ASSERT_LE(statistics.contentions, statistics.acquisitions);
+    ASSERT_GE(statistics.hold_time.count(), 0);
+
+    pair.telemetry().reset();
+    ASSERT_EQ(pair.telemetry().statistics().acquisitions, 0u);
+}
+
+struct CountedPoint {
+    static inline int constructions = 0;
+    CountedPoint() { ++constructions; }
+    int x = 0;
+};
+
+TEST(LTL_test, test_mutex_policies) {
+    checkMutexPolicy<ltl::exclusive_policy>();
+    checkMutexPolicy<ltl::shared_policy>();
+    checkMutexPolicy<ltl::spin_policy>();
+    checkMutexPolicy<ltl::seqlock_policy>();
+
+    // Only the seqlock stores a sequence, and the default telemetry takes no space
+    struct Unlocked {
+        int value;
+        ltl::spin_mutex mutex;
+    };
+    static_assert(sizeof(ltl::mutex<int, ltl::spin_policy>) == sizeof(Unlocked));
+    static_assert(sizeof(ltl::mutex<int, ltl::seqlock_policy>) > sizeof(Unlocked));
+
+    // The readers of a seqlock copy the value without building a T first
+    CountedPoint::constructions = 0;
+    ltl::mutex<CountedPoint, ltl::seqlock_policy> point;
+    point.with_lock([](CountedPoint &p) { p.x = 3; });
+    ASSERT_EQ(std::as_const(point).with_lock([](const CountedPoint &p) { return p.x; }), 3);
+    ASSERT_EQ(CountedPoint::constructions, 1);
+}
+
+TEST(LTL_test, test_thread_pool) {
+    ltl::thread_pool pool{2};
+    ASSERT_EQ(pool.size(), 2);
+
+    auto answer = pool.submit([] { return 42; });
+    ASSERT_EQ(pool.get(answer), 42);
+
+    auto failure = pool.submit([]() -> int { throw std::runtime_error{"failure"}; });
+    ASSERT_THROW(pool.get(failure), std::runtime_error);
+
+    auto nested = pool.submit([&pool] {
+        std::vector<std::future<int>> futures;
+        for (int i = 0; i < 16; ++i)
+            futures.push_back(pool.submit([i] { return i; }));
+        int result = 0;
+        for (auto &future : futures)
+            result += pool.get(future);
+        return result;
+    });
+    ASSERT_EQ(pool.get(nested), 120);
+
+    // The task is moved in the pool, and the main thread sleeps while it runs
+    auto moveOnly = pool.submit([value = std::make_unique<int>(5)] {
+        std::this_thread::sleep_for(std::chrono::milliseconds{5});
+        return *value;
+    });
+    pool.wait(moveOnly);
+    ASSERT_EQ(moveOnly.wait_for(std::chrono::seconds{0}), std::future_status::ready);
+    ASSERT_EQ(pool.get(moveOnly), 5);
+
+    std::vector<int> values(1000, 1);
+    pool.parallel_for(values, [](int &x) { x *= 2; });
+    ASSERT_TRUE(ltl::all_of(values, [](int x) { return x == 2; }));
+
+    std::list<int> list(100, 1);
+    std::atomic<int> sum{0};
+    ltl::parallel_for(list | ltl::filter([](int x) { return x == 1; }), [&sum](int x) { sum += x; });
+    ASSERT_EQ(sum, 100);
+
+    ASSERT_THROW(pool.parallel_for(values, [](int) { throw std::runtime_error{"failure"}; }), std::runtime_error);
+
+    // The exception is rethrown once the other chunks are done: they do not use f after parallel_for has returned
+    std::atomic<int> calls{0};
+    std::string captured = "value";
+    ASSERT_THROW(pool.parallel_for(values,
+                                   [&calls, &values, captured](const int &x) {
+                                       if (&x == &values.front())
+                                           throw std::runtime_error{"failure"};
+                                       std::this_thread::sleep_for(std::chrono::microseconds{10});
+                                       calls += captured.size();
+                                   }),
+                 std::runtime_error);
+    const int callsAfterThrow = calls;
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    ASSERT_EQ(calls, callsAfterThrow);
+}
+
 TEST(LTL_test, test_finally) {
     int x = 0;
     {
@@ -2497,6 +3654,69 @@ ltl::expected<double, const char *> g(bool success) { co_return co_await h(succe
 ltl::expected<double, std::string_view> f(bool success) { co_return co_await g(success) * 10; }
 } // namespace ex
 
+namespace gen {
+ltl::generator<int> iota(int n) {
+    for (int i = 0; i < n; ++i)
+        co_yield i;
+}
+
+ltl::generator<int> naturals() {
+    for (int i = 0;; ++i)
+        co_yield i;
+}
+
+ltl::generator<std::string> throwing() {
+    co_yield "first";
+    throw std::runtime_error("generator");
+}
+} // namespace gen
+
+TEST(LTL_test, test_generator) {
+    using namespace ltl;
+    auto is_even = [](auto x) { return x % 2 == 0; };
+
+    ASSERT_TRUE(equal(gen::iota(5), std::array{0, 1, 2, 3, 4}));
+    ASSERT_TRUE(gen::iota(0).empty());
+    ASSERT_EQ(gen::iota(5) | actions::sum, 10);
+    ASSERT_EQ(gen::iota(10) | filter(is_even) | map([](int x) { return x * x; }) | actions::sum, 120);
+
+    // take_n does not read the element after the last one it gives
+    auto numbers = gen::naturals();
+    std::vector<int> first = numbers | take_n(3);
+    std::vector<int> next = numbers | take_while([](int x) { return x < 6; });
+    ASSERT_EQ(first, (std::vector<int>{0, 1, 2}));
+    ASSERT_EQ(next, (std::vector<int>{2, 3, 4, 5}));
+    ASSERT_EQ(*numbers.begin(), 6);
+    ASSERT_TRUE(equal(gen::naturals() | filter(is_even) | drop_n(2) | take_n(3), std::array{4, 6, 8}));
+
+    // The elements are skipped once, even if the range is read several times
+    auto dropped = gen::iota(10) | drop_n(2);
+    ASSERT_FALSE(dropped.empty());
+    ASSERT_EQ(dropped.front(), 2);
+    ASSERT_TRUE(equal(dropped, std::array{2, 3, 4, 5, 6, 7, 8, 9}));
+    ASSERT_TRUE(equal(gen::iota(10) | drop_while([](int x) { return x < 7; }) | map([](int x) { return x * 2; }),
+                      std::array{14, 16, 18}));
+
+    std::vector<std::string> strings;
+    auto throwingRange = gen::throwing();
+    ASSERT_THROW(
+        {
+            for (const std::string &s : throwingRange)
+                strings.push_back(s);
+        },
+        std::runtime_error);
+    ASSERT_EQ(strings, std::vector<std::string>{"first"});
+
+    // The frames are recycled
+    const void *frame = nullptr;
+    for (int i = 0; i < 3; ++i) {
+        auto range = gen::iota(3);
+        const void *current = std::addressof(*range.begin());
+        ASSERT_TRUE(frame == nullptr || frame == current);
+        frame = current;
+    }
+}
+
 TEST(LTL_test, awaiter_optional) {
     ASSERT_FALSE(opt::h(false));
     ASSERT_EQ(opt::h(true), 5);
@@ -2514,4 +3734,35 @@ TEST(LTL_test, awaiter_expected) {
     ASSERT_EQ(ex::f(false).error(), "Error"sv);
     ASSERT_EQ(ex::f(true).result(), 5 * 2.5 * 10);
 }
+
+// The awaited objects are not copied: an lvalue is still valid after co_await
+namespace lv {
+ltl::expected<std::string, int> name(bool success) {
+    if (success)
+        co_return "name";
+    co_return 3;
+}
+
+ltl::expected<std::size_t, int> twice(bool success) {
+    auto e = name(success);
+    std::string a = co_await e;
+    std::string b = co_await std::move(e);
+    co_return a.size() + b.size();
+}
+
+ltl::optional<std::string> concatenate(bool success) {
+    ltl::optional<std::string> o;
+    if (success)
+        o = "abc";
+    std::string s = co_await o;
+    co_return s + co_await o;
+}
+} // namespace lv
+
+TEST(LTL_test, awaiter_lvalue) {
+    ASSERT_EQ(lv::twice(true).result(), 8u);
+    ASSERT_EQ(lv::twice(false).error(), 3);
+    ASSERT_EQ(*lv::concatenate(true), "abcabc");
+    ASSERT_FALSE(lv::concatenate(false));
+}
 #endif
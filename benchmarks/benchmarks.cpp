@@ -1,18 +1,39 @@
 #include <random>
+#include <fstream>
+#include <cstdio>
+#include <deque>
+#include <list>
 
+#include <ltl/mmap.h>
 #include <ltl/algos.h>
+#include <ltl/stream.h>
+#include <ltl/thread.h>
+#include <ltl/serialize.h>
 #include <ltl/functional.h>
+#include <ltl/operator.h>
+#include <ltl/movable_any.h>
+#include <ltl/VariantUtils.h>
 
 #include <ltl/Range/Map.h>
+#include <ltl/Range/seq.h>
+#include <ltl/Range/Split.h>
 #include <ltl/Range/Filter.h>
+#include <ltl/Range/SplitView.h>
+#include <ltl/Range/Zip.h>
+#include <ltl/Range/Join.h>
+#include <ltl/Range/Reverse.h>
 #include <ltl/Range/actions.h>
+#include <ltl/Range/generator.h>
 
 #include <ltl/expected.h>
+#include <ltl/optional.h>
 #include <benchmark/benchmark.h>
 
 using namespace ltl;
 
 #define RANGE ->Args({10000, false})->Args({10000, true})->Args({100'000, false})->Args({100'000, true});
+#define THREADS ->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+#define SIZES ->Arg(1000)->Arg(100'000);
 
 std::vector<std::size_t> createArray(int64_t count, bool sorted) {
     std::vector<std::size_t> a;
@@ -48,6 +69,59 @@ static void sum_square_range(benchmark::State &state) {
     }
 }
 
+static void sum_square_fast(benchmark::State &state) {
+    auto vector = createArray(state.range(0), state.range(1));
+
+    for (auto _ : state) {
+        auto square = [](auto &&x) { return x * x; };
+        benchmark::DoNotOptimize(vector | map(square) | actions::sum_fast);
+    }
+}
+
+static void sum_square_double_normal(benchmark::State &state) {
+    auto array = createArray(state.range(0), state.range(1));
+    std::vector<double> vector(array.begin(), array.end());
+
+    for (auto _ : state) {
+        double result = 0;
+        for (auto x : vector) {
+            result += x * x;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+static void sum_square_double_fast(benchmark::State &state) {
+    auto array = createArray(state.range(0), state.range(1));
+    std::vector<double> vector(array.begin(), array.end());
+
+    for (auto _ : state) {
+        auto square = [](auto &&x) { return x * x; };
+        benchmark::DoNotOptimize(vector | map(square) | actions::sum_fast);
+    }
+}
+
+static void sum_square_parallel(benchmark::State &state) {
+    auto vector = createArray(1'000'000, false);
+    ltl::thread_pool pool{static_cast<std::size_t>(state.range(0))};
+
+    for (auto _ : state) {
+        auto square = [](auto &&x) { return x * x; };
+        benchmark::DoNotOptimize(vector | par(pool) | map(square) | actions::sum);
+    }
+}
+
+static void sum_square_odd_parallel(benchmark::State &state) {
+    auto vector = createArray(1'000'000, false);
+    ltl::thread_pool pool{static_cast<std::size_t>(state.range(0))};
+
+    for (auto _ : state) {
+        auto is_odd = [](auto &&x) { return x % 2 == 1; };
+        auto square = [](auto &&x) { return x * x; };
+        benchmark::DoNotOptimize(vector | par(pool) | filter(is_odd) | map(square) | actions::sum);
+    }
+}
+
 static void sum_square_odd_normal(benchmark::State &state) {
     auto vector = createArray(state.range(0), state.range(1));
 
@@ -90,6 +164,651 @@ static void sum_filter_double(benchmark::State &state) {
     }
 }
 
+static void sum_filter_filter_map_normal(benchmark::State &state) {
+    auto vector = createArray(state.range(0), state.range(1));
+
+    for (auto _ : state) {
+        std::size_t result = 0;
+        for (auto x : vector) {
+            if (x % 2 == 1 && x % 3 == 0)
+                result += x * x;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+static void sum_filter_filter_map_range(benchmark::State &state) {
+    auto vector = createArray(state.range(0), state.range(1));
+
+    for (auto _ : state) {
+        auto is_odd = [](auto x) { return x % 2 == 1; };
+        auto is_multiple_of_3 = [](auto x) { return x % 3 == 0; };
+        auto square = [](auto x) { return x * x; };
+        benchmark::DoNotOptimize(vector | filter(is_odd) | filter(is_multiple_of_3) | map(square) | actions::sum);
+    }
+}
+
+static void find_id_std(benchmark::State &state) {
+    std::vector<std::uint32_t> ids(state.range(0));
+    std::iota(ids.begin(), ids.end(), 0u);
+    const auto last = static_cast<std::uint32_t>(ids.size() - 1);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::find(ids.begin(), ids.end(), last));
+        benchmark::DoNotOptimize(std::count(ids.begin(), ids.end(), last));
+    }
+}
+
+static void find_id_ltl(benchmark::State &state) {
+    std::vector<std::uint32_t> ids(state.range(0));
+    std::iota(ids.begin(), ids.end(), 0u);
+    const auto last = static_cast<std::uint32_t>(ids.size() - 1);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ltl::find(ids, last));
+        benchmark::DoNotOptimize(ltl::count(ids, last));
+    }
+}
+
+static void find_char_std(benchmark::State &state) {
+    std::string text(state.range(0), 'a');
+    text.back() = 'b';
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::find(text.begin(), text.end(), 'b'));
+        benchmark::DoNotOptimize(std::count(text.begin(), text.end(), 'b'));
+    }
+}
+
+static void find_char_ltl(benchmark::State &state) {
+    std::string text(state.range(0), 'a');
+    text.back() = 'b';
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ltl::find(text, 'b'));
+        benchmark::DoNotOptimize(ltl::count(text, 'b'));
+    }
+}
+
+struct SortRecord {
+    std::uint64_t key;
+    std::uint64_t payload;
+};
+
+static std::vector<SortRecord> createRecords(std::size_t count) {
+    std::mt19937_64 generator;
+    std::vector<SortRecord> records(count);
+    // Identifiers below one billion: the four high bytes of the keys are always 0
+    for (auto &record : records)
+        record = {generator() % 1'000'000'000, 0};
+    return records;
+}
+
+static void sort_records_std(benchmark::State &state) {
+    auto records = createRecords(1'000'000);
+
+    for (auto _ : state) {
+        auto copy = records;
+        std::sort(copy.begin(), copy.end(), [](const auto &a, const auto &b) { return a.key < b.key; });
+        benchmark::DoNotOptimize(copy.data());
+    }
+}
+
+static void sort_records_radix(benchmark::State &state) {
+    auto records = createRecords(1'000'000);
+    ltl::thread_pool pool{static_cast<std::size_t>(state.range(0))};
+
+    for (auto _ : state) {
+        auto copy = records;
+        copy |= par(pool) | actions::sort_by_ascending(&SortRecord::key);
+        benchmark::DoNotOptimize(copy.data());
+    }
+}
+
+// The radix sort moves the keys of these records with their positions, then every record once
+struct LargeSortRecord {
+    std::uint64_t key;
+    std::array<char, 248> payload;
+};
+
+static std::vector<LargeSortRecord> createLargeRecords(std::size_t count) {
+    std::mt19937_64 generator;
+    std::vector<LargeSortRecord> records(count);
+    for (auto &record : records)
+        record.key = generator() % 1'000'000'000;
+    return records;
+}
+
+static void sort_large_records_std(benchmark::State &state) {
+    auto records = createLargeRecords(500'000);
+
+    for (auto _ : state) {
+        auto copy = records;
+        std::sort(copy.begin(), copy.end(), [](const auto &a, const auto &b) { return a.key < b.key; });
+        benchmark::DoNotOptimize(copy.data());
+    }
+}
+
+static void sort_large_records_radix(benchmark::State &state) {
+    auto records = createLargeRecords(500'000);
+    ltl::thread_pool pool{static_cast<std::size_t>(state.range(0))};
+
+    for (auto _ : state) {
+        auto copy = records;
+        copy |= par(pool) | actions::sort_by_ascending(&LargeSortRecord::key);
+        benchmark::DoNotOptimize(copy.data());
+    }
+}
+
+static std::string createLog(std::size_t lineCount) {
+    std::mt19937 generator;
+    std::string log;
+    for (std::size_t i = 0; i < lineCount; ++i)
+        log += std::string(20 + generator() % 100, 'a') + '\n';
+    return log;
+}
+
+static void split_lines_range(benchmark::State &state) {
+    auto log = createLog(state.range(0));
+    auto to_size = [](auto &&r) { return r.size(); };
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(log | ltl::split('\n') | map(to_size) | actions::sum);
+}
+
+static void split_lines_view(benchmark::State &state) {
+    auto log = createLog(state.range(0));
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(log | ltl::split_view('\n') | map(&std::string_view::size) | actions::sum);
+}
+
+static void split_lines_parallel(benchmark::State &state) {
+    auto log = createLog(1'000'000);
+    ltl::thread_pool pool{static_cast<std::size_t>(state.range(0))};
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(log | ltl::split_view('\n') | par(pool) | map(&std::string_view::size) | actions::sum);
+}
+
+static const char *createRecordFile() {
+    static const char *path = "ltl_benchmark_records.bin";
+    auto records = createRecords(1'000'000);
+    std::ofstream{path, std::ios::binary}.write(reinterpret_cast<const char *>(records.data()),
+                                                records.size() * sizeof(SortRecord));
+    return path;
+}
+
+static void load_records_ifstream(benchmark::State &state) {
+    auto path = createRecordFile();
+
+    for (auto _ : state) {
+        std::ifstream file{path, std::ios::binary};
+        std::vector<SortRecord> records(1'000'000);
+        file.read(reinterpret_cast<char *>(records.data()), records.size() * sizeof(SortRecord));
+        benchmark::DoNotOptimize(records | map(&SortRecord::key) | actions::sum);
+    }
+    std::remove(path);
+}
+
+static void load_records_mmap(benchmark::State &state) {
+    auto path = createRecordFile();
+
+    for (auto _ : state) {
+        auto records = make_mmap_range<SortRecord>(path, mmap_advice::sequential);
+        benchmark::DoNotOptimize(records.result() | map(&SortRecord::key) | actions::sum);
+    }
+    std::remove(path);
+}
+
+static void stream_write_read(benchmark::State &state) {
+    std::array<char, 64> record{};
+
+    for (auto _ : state) {
+        ltl::writeonly_streambuf<std::vector<std::uint8_t>> writebuf;
+        std::ostream ostream(&writebuf);
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            record[0] = static_cast<char>(i);
+            ostream.write(record.data(), record.size());
+        }
+
+        ltl::readonly_streambuf<std::vector<std::uint8_t>> readbuf{writebuf.takeContainer()};
+        std::istream istream(&readbuf);
+        std::size_t sum = 0;
+        while (istream.read(record.data(), record.size()))
+            sum += record[0];
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+// A batch of frames of 100 bytes is received, each frame is released once parsed
+template <typename Streambuf>
+static void parse_frames(benchmark::State &state, Streambuf &streambuf) {
+    std::vector<char> batch(state.range(0), 'f');
+    std::array<char, 100> frame;
+    std::istream stream(&streambuf);
+
+    for (auto _ : state) {
+        streambuf.feed(batch);
+        while (stream.read(frame.data(), frame.size()))
+            stream.rdbuf()->pubsync();
+        stream.clear();
+        stream.seekg(-stream.gcount(), std::ios_base::cur);
+    }
+}
+
+static void stream_frames_readonly(benchmark::State &state) {
+    ltl::readonly_streambuf<std::vector<char>> streambuf{std::vector<char>()};
+    parse_frames(state, streambuf);
+}
+
+static void stream_frames_ring(benchmark::State &state) {
+    ltl::ring_streambuf streambuf{static_cast<std::size_t>(state.range(0)) + 100};
+    parse_frames(state, streambuf);
+}
+
+// Records of an id and 16 values
+using SerializedRecord = ltl::tuple_t<std::uint64_t, std::vector<double>>;
+
+static auto createSerializedRecords(int64_t count) {
+    std::vector<SerializedRecord> records;
+    for (int64_t i = 0; i < count; ++i)
+        records.push_back(SerializedRecord{static_cast<std::uint64_t>(i), std::vector<double>(16, double(i))});
+    return records;
+}
+
+static void serialize_as_byte(benchmark::State &state) {
+    auto records = createSerializedRecords(state.range(0));
+
+    for (auto _ : state) {
+        ltl::writeonly_streambuf<std::vector<std::uint8_t>> streambuf;
+        std::ostream stream(&streambuf);
+        stream << ltl::as_byte(records.size());
+        for (const auto &[id, values] : records) {
+            stream << ltl::as_byte(id) << ltl::as_byte(values.size());
+            for (double value : values)
+                stream << ltl::as_byte(value);
+        }
+        benchmark::DoNotOptimize(streambuf.takeContainer());
+    }
+}
+
+static void serialize_ltl(benchmark::State &state) {
+    auto records = createSerializedRecords(state.range(0));
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(ltl::serialize(records));
+}
+
+static void deserialize_as_byte(benchmark::State &state) {
+    ltl::writeonly_streambuf<std::vector<std::uint8_t>> writebuf;
+    std::ostream ostream(&writebuf);
+    auto records = createSerializedRecords(state.range(0));
+    ostream << ltl::as_byte(records.size());
+    for (const auto &[id, values] : records) {
+        ostream << ltl::as_byte(id) << ltl::as_byte(values.size());
+        for (double value : values)
+            ostream << ltl::as_byte(value);
+    }
+    auto bytes = writebuf.takeContainer();
+
+    for (auto _ : state) {
+        ltl::readonly_streambuf<std::vector<std::uint8_t>> readbuf{bytes};
+        std::istream istream(&readbuf);
+        std::size_t size;
+        istream >> ltl::as_byte(size);
+        std::vector<SerializedRecord> decoded(size);
+        for (auto &[id, values] : decoded) {
+            istream >> ltl::as_byte(id) >> ltl::as_byte(size);
+            values.resize(size);
+            for (double &value : values)
+                istream >> ltl::as_byte(value);
+        }
+        benchmark::DoNotOptimize(decoded);
+    }
+}
+
+static void deserialize_ltl(benchmark::State &state) {
+    auto bytes = ltl::serialize(createSerializedRecords(state.range(0)));
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(ltl::deserialize<std::vector<SerializedRecord>>(bytes));
+}
+
+// Many short sequences of 16 elements
+static void short_sequences_seq(benchmark::State &state) {
+    for (auto _ : state) {
+        auto generator = [i = 0]() mutable {
+            if (i == 16)
+                end_seq();
+            return i++;
+        };
+        benchmark::DoNotOptimize(seq(generator) | actions::sum);
+    }
+}
+
+#if LTL_COROUTINE
+static ltl::generator<int> sixteenNumbers() {
+    for (int i = 0; i < 16; ++i)
+        co_yield i;
+}
+
+static void short_sequences_generator(benchmark::State &state) {
+    for (auto _ : state)
+        benchmark::DoNotOptimize(sixteenNumbers() | actions::sum);
+}
+#endif
+
+// A queue of messages: one int out of two, and a small struct for the others
+struct Position {
+    double x, y, z;
+};
+
+template <typename Any>
+static void any_queue(benchmark::State &state) {
+    const auto size = state.range(0);
+
+    for (auto _ : state) {
+        std::deque<Any> queue;
+        for (int i = 0; i < size; ++i) {
+            if (i % 2)
+                queue.emplace_back(i);
+            else
+                queue.emplace_back(Position{double(i), 0.0, 0.0});
+        }
+
+        double total = 0;
+        while (!queue.empty()) {
+            Any message = std::move(queue.front());
+            queue.pop_front();
+            if (message.type() == typeid(int))
+                total += message.template get<int>();
+            else
+                total += message.template get<Position>().x;
+        }
+        benchmark::DoNotOptimize(total);
+    }
+}
+
+static void any_queue_movable_any(benchmark::State &state) { any_queue<ltl::movable_any>(state); }
+static void any_queue_unique_any(benchmark::State &state) { any_queue<ltl::unique_any<>>(state); }
+
+// A balanced expression tree of additions, built then evaluated
+template <template <typename> typename Wrapper>
+struct AddNode {
+    using expression = ltl::recursive_variant<int, Wrapper<AddNode>>;
+    expression lhs, rhs;
+};
+
+template <template <typename> typename Wrapper>
+static typename AddNode<Wrapper>::expression buildAddTree(int depth, int &leaf) {
+    if (depth == 0)
+        return leaf++;
+    return AddNode<Wrapper>{buildAddTree<Wrapper>(depth - 1, leaf), buildAddTree<Wrapper>(depth - 1, leaf)};
+}
+
+template <template <typename> typename Wrapper>
+static long long evaluateAddTree(const typename AddNode<Wrapper>::expression &expression) {
+    long long result = 0;
+    recursive_visit(overloader{[&result](int x) { result = x; },
+                               [&result](const AddNode<Wrapper> &node) {
+                                   result = evaluateAddTree<Wrapper>(node.lhs) + evaluateAddTree<Wrapper>(node.rhs);
+                               }},
+                    expression);
+    return result;
+}
+
+static void expression_tree_heap(benchmark::State &state) {
+    for (auto _ : state) {
+        int leaf = 0;
+        auto tree = buildAddTree<ltl::recursive_wrapper>(state.range(0), leaf);
+        benchmark::DoNotOptimize(evaluateAddTree<ltl::recursive_wrapper>(tree));
+    }
+}
+
+static void expression_tree_arena(benchmark::State &state) {
+    for (auto _ : state) {
+        std::pmr::monotonic_buffer_resource arena;
+        int leaf = 0;
+        auto tree = [&] {
+            ltl::arena_scope scope{arena};
+            return buildAddTree<ltl::arena_recursive_wrapper>(state.range(0), leaf);
+        }();
+        benchmark::DoNotOptimize(evaluateAddTree<ltl::arena_recursive_wrapper>(tree));
+    }
+}
+
+// Visit 10000 variants of N alternatives
+template <std::size_t I>
+struct Alternative {
+    static constexpr int index = I;
+    int value;
+};
+
+template <std::size_t... Is>
+static auto makeAlternatives(std::index_sequence<Is...>) -> std::variant<Alternative<Is>...>;
+
+template <std::size_t N>
+using ManyAlternatives = decltype(makeAlternatives(std::make_index_sequence<N>{}));
+
+template <std::size_t N, std::size_t... Is>
+static ManyAlternatives<N> makeAlternative(std::size_t index, int value, std::index_sequence<Is...>) {
+    ManyAlternatives<N> variant;
+    ((index == Is ? void(variant.template emplace<Is>(Alternative<Is>{value})) : void()), ...);
+    return variant;
+}
+
+template <std::size_t N>
+static std::vector<ManyAlternatives<N>> createAlternatives() {
+    std::mt19937 generator;
+    std::uniform_int_distribution<std::size_t> distribution(0, N - 1);
+    std::vector<ManyAlternatives<N>> variants;
+    for (int i = 0; i < 10000; ++i)
+        variants.push_back(makeAlternative<N>(distribution(generator), i, std::make_index_sequence<N>{}));
+    return variants;
+}
+
+constexpr auto weightAlternative = [](const auto &alternative) { return alternative.value * alternative.index; };
+
+template <std::size_t N>
+static void visit_std(benchmark::State &state) {
+    auto variants = createAlternatives<N>();
+
+    for (auto _ : state) {
+        long long total = 0;
+        for (const auto &variant : variants)
+            total += std::visit(weightAlternative, variant);
+        benchmark::DoNotOptimize(total);
+    }
+}
+
+template <std::size_t N>
+static void visit_ltl(benchmark::State &state) {
+    auto variants = createAlternatives<N>();
+
+    for (auto _ : state) {
+        long long total = 0;
+        for (const auto &variant : variants)
+            total += ltl::visit(weightAlternative, variant);
+        benchmark::DoNotOptimize(total);
+    }
+}
+
+// One thread writes a position, the other ones read it
+template <typename Policy>
+static void mutex_read_mostly(benchmark::State &state) {
+    static ltl::mutex<Position, Policy> position;
+
+    for (auto _ : state) {
+        if (state.thread_index() == 0)
+            position.with_lock([](Position &p) { p.x += 1.0; });
+        else
+            benchmark::DoNotOptimize(std::as_const(position).with_lock([](const Position &p) { return p.x; }));
+    }
+}
+
+// Materialize filter | map into a vector, one element out of two is kept
+static void materialize_constructor(benchmark::State &state) {
+    auto vector = createArray(state.range(0), false);
+
+    for (auto _ : state) {
+        auto odds = vector | filter([](auto x) { return x % 2 == 1; }) | map([](auto x) { return x * 1.5; });
+        benchmark::DoNotOptimize(std::vector<double>(odds.begin(), odds.end()));
+    }
+}
+
+static void materialize_ltl(benchmark::State &state) {
+    auto vector = createArray(state.range(0), false);
+
+    for (auto _ : state) {
+        auto odds = vector | filter([](auto x) { return x % 2 == 1; }) | map([](auto x) { return x * 1.5; });
+        benchmark::DoNotOptimize(odds | ltl::to<std::vector>());
+    }
+}
+
+// size() and operator[] of sized views, called in a loop
+static void zip_size_index(benchmark::State &state) {
+    auto vector = createArray(state.range(0), false);
+    std::vector<double> weights(vector.size(), 0.5);
+
+    for (auto _ : state) {
+        auto zipped = ltl::zip(vector, weights);
+        auto reversedVector = vector | ltl::reversed;
+        std::size_t result = 0;
+        for (int i = 0; i < 16; ++i)
+            result += zipped.size() + reversedVector.size() + reversedVector[i];
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+static void filter_size_back(benchmark::State &state) {
+    auto vector = createArray(state.range(0), state.range(1));
+
+    for (auto _ : state) {
+        auto is_odd = [](auto &&x) { return x % 2 == 1; };
+        auto odds = vector | filter(is_odd);
+        std::size_t result = 0;
+        for (int i = 0; i < 16; ++i)
+            result += odds.size() + odds.back();
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+static void select_size_back(benchmark::State &state) {
+    auto vector = createArray(state.range(0), state.range(1));
+
+    for (auto _ : state) {
+        auto is_odd = [](auto &&x) { return x % 2 == 1; };
+        auto odds = vector | select(is_odd);
+        std::size_t result = 0;
+        for (int i = 0; i < 16; ++i)
+            result += odds.size() + odds.back();
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+// Dot product of two arrays: a plain indexed loop against zip | map | sum
+static void zip_dot_loop(benchmark::State &state) {
+    std::vector<int> xs(state.range(0), 3);
+    std::vector<int> ys(state.range(0), 2);
+
+    for (auto _ : state) {
+        int result = 0;
+        for (std::size_t i = 0; i < xs.size(); ++i)
+            result += xs[i] * ys[i];
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+static void zip_dot_ltl(benchmark::State &state) {
+    std::vector<int> xs(state.range(0), 3);
+    std::vector<int> ys(state.range(0), 2);
+
+    for (auto _ : state) {
+        auto products = ltl::zip(xs, ys) | map([](auto t) {
+                            auto [x, y] = t;
+                            return x * y;
+                        });
+        int result = products | ltl::actions::sum;
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+// Buckets of 64 elements, walked through join
+template <typename Bucket>
+static std::vector<Bucket> createBuckets(int64_t count) {
+    std::vector<Bucket> buckets(count / 64);
+    for (std::size_t i = 0; i < buckets.size(); ++i)
+        for (int j = 0; j < 64; ++j)
+            buckets[i].push_back(i + j);
+    return buckets;
+}
+
+static void join_list_iterate(benchmark::State &state) {
+    auto buckets = createBuckets<std::list<int>>(state.range(0));
+
+    for (auto _ : state) {
+        int result = 0;
+        for (int x : buckets | ltl::join)
+            result += x;
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+static void join_vector_sum(benchmark::State &state) {
+    auto buckets = createBuckets<std::vector<int>>(state.range(0));
+
+    for (auto _ : state) {
+        int result = buckets | ltl::join | ltl::actions::sum;
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+static void join_map_sum(benchmark::State &state) {
+    auto buckets = createBuckets<std::vector<int>>(state.range(0));
+
+    for (auto _ : state) {
+        auto odds = buckets >> map([](const auto &bucket) { return bucket | filter([](int x) { return x % 2; }); });
+        int result = odds | ltl::actions::sum;
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+static void join_count_if(benchmark::State &state) {
+    auto buckets = createBuckets<std::vector<int>>(state.range(0));
+
+    for (auto _ : state) {
+        auto result = ltl::count_if(buckets | ltl::join, [](int x) { return x % 3 == 0; });
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+static void join_find_if(benchmark::State &state) {
+    auto buckets = createBuckets<std::vector<int>>(state.range(0));
+    const int target = static_cast<int>(buckets.size() + 62);
+
+    for (auto _ : state) {
+        auto joined = buckets | ltl::join;
+        auto it = ltl::find_if(joined, [target](int x) { return x == target; });
+        benchmark::DoNotOptimize(it);
+    }
+}
+
+static void chunks_join_sum(benchmark::State &state) {
+    std::vector<int> vector(state.range(0), 1);
+
+    for (auto _ : state) {
+        int result = vector | ltl::chunks(64) | ltl::join | ltl::actions::sum;
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+// The success flag is hidden from the optimizer, so the error paths are not folded at compile time
+static bool unknown(bool success) {
+    benchmark::DoNotOptimize(success);
+    return success;
+}
+
 static ltl::expected<int, const char *> fExpected(bool success) {
     if (!success)
         return "Error";
@@ -104,13 +823,37 @@ static ltl::expected<double, const char *> gExpected(bool success) {
 
 static void expected_result(benchmark::State &state) {
     for (auto _ : state) {
-        benchmark::DoNotOptimize(gExpected(true));
+        benchmark::DoNotOptimize(gExpected(unknown(true)));
     }
 }
 
 static void expected_error(benchmark::State &state) {
     for (auto _ : state) {
-        benchmark::DoNotOptimize(gExpected(false));
+        benchmark::DoNotOptimize(gExpected(unknown(false)));
+    }
+}
+
+static ltl::optional<int> fOptional(bool success) {
+    if (!success)
+        return ltl::nullopt;
+    return 10;
+}
+
+static ltl::optional<double> gOptional(bool success) {
+    return fOptional(success).map([](int x) { //
+        return x * 1.5;
+    });
+}
+
+static void optional_result(benchmark::State &state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(gOptional(unknown(true)));
+    }
+}
+
+static void optional_error(benchmark::State &state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(gOptional(unknown(false)));
     }
 }
 
@@ -126,16 +869,27 @@ static ltl::expected<double, const char *> gMonade(bool success) { co_return co_
 
 static void monade_result(benchmark::State &state) {
     for (auto _ : state) {
-        benchmark::DoNotOptimize(gMonade(true));
+        benchmark::DoNotOptimize(gMonade(unknown(true)));
     }
 }
 
 static void monade_error(benchmark::State &state) {
     for (auto _ : state) {
-        try {
-            benchmark::DoNotOptimize(gMonade(false));
-        } catch (const char *) {
-        }
+        benchmark::DoNotOptimize(gMonade(unknown(false)));
+    }
+}
+
+static ltl::optional<double> gMonadeOptional(bool success) { co_return co_await fOptional(success) * 1.5; }
+
+static void monade_optional_result(benchmark::State &state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(gMonadeOptional(unknown(true)));
+    }
+}
+
+static void monade_optional_error(benchmark::State &state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(gMonadeOptional(unknown(false)));
     }
 }
 #endif
@@ -150,14 +904,14 @@ static double gException(bool success) { return fException(success) * 1.5; }
 
 static void exception_result(benchmark::State &state) {
     for (auto _ : state) {
-        benchmark::DoNotOptimize(gException(true));
+        benchmark::DoNotOptimize(gException(unknown(true)));
     }
 }
 
 static void exception_error(benchmark::State &state) {
     for (auto _ : state) {
         try {
-            benchmark::DoNotOptimize(gException(false));
+            benchmark::DoNotOptimize(gException(unknown(false)));
         } catch (const char *) {
         }
     }
@@ -166,12 +920,88 @@ static void exception_error(benchmark::State &state) {
 // Register the function as a benchmark
 BENCHMARK(sum_square_normal) RANGE;
 BENCHMARK(sum_square_range) RANGE;
+BENCHMARK(sum_square_fast) RANGE;
+BENCHMARK(sum_square_double_normal) RANGE;
+BENCHMARK(sum_square_double_fast) RANGE;
+BENCHMARK(sum_square_parallel) THREADS;
+BENCHMARK(sum_square_odd_parallel) THREADS;
 
 BENCHMARK(sum_square_odd_normal) RANGE;
 BENCHMARK(sum_square_odd_range) RANGE;
 
 BENCHMARK(sum_filter_single) RANGE;
 BENCHMARK(sum_filter_double) RANGE;
+BENCHMARK(sum_filter_filter_map_normal) RANGE;
+BENCHMARK(sum_filter_filter_map_range) RANGE;
+
+BENCHMARK(find_id_std) SIZES;
+BENCHMARK(find_id_ltl) SIZES;
+BENCHMARK(find_char_std) SIZES;
+BENCHMARK(find_char_ltl) SIZES;
+
+BENCHMARK(sort_records_std)->UseRealTime();
+BENCHMARK(sort_records_radix) THREADS;
+BENCHMARK(sort_large_records_std)->UseRealTime();
+BENCHMARK(sort_large_records_radix) THREADS;
+
+BENCHMARK(split_lines_range) SIZES;
+BENCHMARK(split_lines_view) SIZES;
+BENCHMARK(split_lines_parallel) THREADS;
+
+BENCHMARK(load_records_ifstream);
+BENCHMARK(load_records_mmap);
+
+BENCHMARK(stream_write_read) SIZES;
+
+BENCHMARK(stream_frames_readonly) SIZES;
+BENCHMARK(stream_frames_ring) SIZES;
+
+BENCHMARK(serialize_as_byte) SIZES;
+BENCHMARK(serialize_ltl) SIZES;
+BENCHMARK(deserialize_as_byte) SIZES;
+BENCHMARK(deserialize_ltl) SIZES;
+
+BENCHMARK(short_sequences_seq);
+
+#if LTL_COROUTINE
+BENCHMARK(short_sequences_generator);
+#endif
+
+BENCHMARK(any_queue_movable_any) SIZES;
+BENCHMARK(any_queue_unique_any) SIZES;
+
+BENCHMARK(expression_tree_heap)->Arg(10)->Arg(16);
+BENCHMARK(expression_tree_arena)->Arg(10)->Arg(16);
+
+BENCHMARK_TEMPLATE(visit_std, 4);
+BENCHMARK_TEMPLATE(visit_ltl, 4);
+BENCHMARK_TEMPLATE(visit_std, 16);
+BENCHMARK_TEMPLATE(visit_ltl, 16);
+BENCHMARK_TEMPLATE(visit_std, 64);
+BENCHMARK_TEMPLATE(visit_ltl, 64);
+
+BENCHMARK_TEMPLATE(mutex_read_mostly, ltl::exclusive_policy)->Threads(1)->Threads(4);
+BENCHMARK_TEMPLATE(mutex_read_mostly, ltl::shared_policy)->Threads(1)->Threads(4);
+BENCHMARK_TEMPLATE(mutex_read_mostly, ltl::spin_policy)->Threads(1)->Threads(4);
+BENCHMARK_TEMPLATE(mutex_read_mostly, ltl::seqlock_policy)->Threads(1)->Threads(4);
+
+BENCHMARK(materialize_constructor)->Arg(1'000'000);
+BENCHMARK(materialize_ltl)->Arg(1'000'000);
+
+BENCHMARK(zip_size_index) SIZES;
+
+BENCHMARK(zip_dot_loop) SIZES;
+BENCHMARK(zip_dot_ltl) SIZES;
+
+BENCHMARK(join_list_iterate) SIZES;
+BENCHMARK(join_vector_sum) SIZES;
+BENCHMARK(join_map_sum) SIZES;
+BENCHMARK(join_count_if) SIZES;
+BENCHMARK(join_find_if) SIZES;
+BENCHMARK(chunks_join_sum) SIZES;
+
+BENCHMARK(filter_size_back) RANGE;
+BENCHMARK(select_size_back) RANGE;
 
 BENCHMARK(expected_result);
 
@@ -188,5 +1018,17 @@ BENCHMARK(monade_error);
 
 BENCHMARK(exception_error);
 
+BENCHMARK(optional_result);
+
+#if LTL_COROUTINE
+BENCHMARK(monade_optional_result);
+#endif
+
+BENCHMARK(optional_error);
+
+#if LTL_COROUTINE
+BENCHMARK(monade_optional_error);
+#endif
+
 // Run the benchmark
 BENCHMARK_MAIN();
@@ -5,7 +5,11 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <optional>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "ltl/crtp.h"
 #include "ltl/traits.h"
@@ -23,6 +27,80 @@ namespace ltl {
 template <typename It>
 using get_iterator_category = typename std::iterator_traits<It>::iterator_category;
 
+template <typename It>
+constexpr bool IsRandomAccessIterator = std::is_base_of_v<std::random_access_iterator_tag, get_iterator_category<It>>;
+
+// Input iterators are single pass: their copies do not keep their position once one of them is incremented
+template <typename It>
+constexpr bool IsForwardIterator = std::is_base_of_v<std::forward_iterator_tag, get_iterator_category<It>>;
+
+/// \cond
+namespace details {
+template <typename It, typename = void>
+struct is_sized_iterator : bool_t<IsRandomAccessIterator<It>> {};
+
+template <typename It>
+struct is_sized_iterator<It, std::void_t<decltype(It::is_sized)>> : bool_t<It::is_sized> {};
+
+template <typename It, typename = void>
+struct has_advance_by : false_t {};
+
+template <typename It>
+struct has_advance_by<It, std::void_t<decltype(std::declval<It &>().advance_by(0ll))>> : true_t {};
+} // namespace details
+/// \endcond
+
+// The distance between two sized iterators is computed without walking the elements between them. The random access
+// iterators are sized, unless they say otherwise with a static is_sized member, as the ones that count by iterating
+template <typename It>
+constexpr bool IsSizedIterator = details::is_sized_iterator<It>::value;
+
+/// \cond
+namespace details {
+template <typename It, typename V = typename std::iterator_traits<It>::value_type, typename = void>
+struct is_contiguous_iterator : std::is_pointer<It> {};
+
+template <typename It, typename V>
+struct is_contiguous_iterator<It, V, std::enable_if_t<!std::is_pointer_v<It> && !std::is_same_v<V, bool>>> :
+    bool_t<std::is_same_v<It, typename std::vector<V>::iterator> ||
+           std::is_same_v<It, typename std::vector<V>::const_iterator> ||
+           std::is_same_v<It, std::string::iterator> || std::is_same_v<It, std::string::const_iterator>> {};
+} // namespace details
+/// \endcond
+
+// Pointers, std::vector and std::string iterators: the elements are adjacent in memory
+template <typename It>
+constexpr bool IsContiguousIterator = details::is_contiguous_iterator<It>::value;
+
+/// \cond
+namespace details {
+// The number of elements between two iterators, or only an upper bound if it cannot be known without walking them
+struct size_hint_t {
+    std::size_t size;
+    bool exact;
+};
+
+template <typename It, typename = void>
+struct has_size_hint : false_t {};
+
+template <typename It>
+struct has_size_hint<It, std::void_t<decltype(std::declval<const It &>().size_hint(std::declval<const It &>()))>> :
+    true_t {};
+
+// An iterator gives its own hint with a member size_hint(last), the sized ones give their distance
+template <typename It>
+std::optional<size_hint_t> size_hint(const It &first, const It &last) {
+    if constexpr (has_size_hint<It>::value) {
+        return first.size_hint(last);
+    } else if constexpr (IsSizedIterator<It>) {
+        return size_hint_t{static_cast<std::size_t>(std::distance(first, last)), true};
+    } else {
+        return std::nullopt;
+    }
+}
+} // namespace details
+/// \endcond
+
 constexpr struct increment_tag_t {
 } increment_tag;
 constexpr struct decrement_tag_t {
@@ -90,13 +168,19 @@ struct IteratorOperationWithDistance {
     }
 };
 
+// The iterator is moved one element at a time, unless it is sized and gives a static distance(first, last) and a
+// member advance_by(n)
 template <typename Derived>
 struct IteratorOperationByIterating {
     ENABLE_CRTP(Derived)
 
+    static constexpr bool is_sized = false;
+
     Derived &operator+=(long long int n) noexcept {
         Derived &it = underlying();
-        if (n > 0) {
+        if constexpr (Derived::is_sized && details::has_advance_by<Derived>::value) {
+            it.advance_by(n);
+        } else if (n > 0) {
             while (n--)
                 ++it;
         } else {
@@ -107,18 +191,27 @@ struct IteratorOperationByIterating {
     }
 
     friend std::size_t operator-(const Derived &b, Derived a) {
-        std::size_t res = 0;
-        for (; a != b; ++res, ++a)
-            ;
-        return res;
+        if constexpr (Derived::is_sized) {
+            return Derived::distance(a, b);
+        } else {
+            std::size_t res = 0;
+            for (; a != b; ++res, ++a)
+                ;
+            return res;
+        }
     }
 };
 
 template <typename It>
 auto safe_advance(It beg, It end, std::size_t n) {
-    while (n-- && beg != end)
-        ++beg;
-    return beg;
+    // A filter is random access but not sized: its distance would walk up to end
+    if constexpr (IsSizedIterator<It>) {
+        return std::next(beg, std::min<std::size_t>(n, std::distance(beg, end)));
+    } else {
+        while (n-- && beg != end)
+            ++beg;
+        return beg;
+    }
 }
 
 } // namespace ltl
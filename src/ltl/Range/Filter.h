@@ -3,6 +3,8 @@
  */
 #pragma once
 
+#include <vector>
+
 #include "Range.h"
 #include "Reverse.h"
 #include "ltl/functional.h"
@@ -45,6 +47,14 @@ class FilterIterator :
         this->m_it = std::find_if(std::next(this->reverse(this->m_it)), this->m_sentinelBegin, this->m_function).m_it;
         return *this;
     }
+
+    // Every element of the source may be kept
+    std::optional<details::size_hint_t> size_hint(const FilterIterator &last) const {
+        auto hint = details::size_hint(this->m_it, last.m_it);
+        if (hint)
+            hint->exact = false;
+        return hint;
+    }
 };
 
 template <typename F>
@@ -52,6 +62,74 @@ struct FilterType {
     F f;
 };
 
+// The positions are indices when the source is sized, else iterators: reaching an index would walk the source
+template <typename It>
+using selection_position_t = std::conditional_t<IsSizedIterator<It>, std::size_t, It>;
+
+template <typename It>
+class SelectIterator :
+    public BaseIterator<SelectIterator<It>, const selection_position_t<It> *>,
+    public IteratorOperationWithDistance<SelectIterator<It>>,
+    public IteratorSimpleComparator<SelectIterator<It>> {
+  public:
+    using reference = typename std::iterator_traits<It>::reference;
+    DECLARE_EVERYTHING_BUT_REFERENCE(std::random_access_iterator_tag);
+
+    SelectIterator() = default;
+
+    SelectIterator(const selection_position_t<It> *position, It source) noexcept :
+        BaseIterator<SelectIterator, const selection_position_t<It> *>{position}, //
+        m_source{std::move(source)} {}
+
+    reference operator*() const {
+        if constexpr (IsSizedIterator<It>) {
+            return *std::next(m_source, *this->m_it);
+        } else {
+            return **this->m_it;
+        }
+    }
+
+  private:
+    It m_source{};
+};
+
+template <typename It>
+class SelectRange : public AbstractRange<SelectRange<It>> {
+  public:
+    template <typename Predicate>
+    SelectRange(It first, It last, const Predicate &predicate) : m_source{first} {
+        if constexpr (IsSizedIterator<It>) {
+            // Branchless: the index is always written, the output only moves forward when the predicate holds
+            m_positions.resize(std::distance(first, last));
+            std::size_t count = 0;
+            for (std::size_t i = 0; first != last; ++first, ++i) {
+                m_positions[count] = i;
+                count += static_cast<bool>(ltl::fast_invoke(predicate, *first));
+            }
+            m_positions.resize(count);
+        } else {
+            for (; first != last; ++first) {
+                if (ltl::fast_invoke(predicate, *first))
+                    m_positions.push_back(first);
+            }
+        }
+    }
+
+    auto begin() const noexcept { return SelectIterator<It>{m_positions.data(), m_source}; }
+    auto end() const noexcept { return SelectIterator<It>{m_positions.data() + m_positions.size(), m_source}; }
+
+    std::size_t size() const noexcept { return m_positions.size(); }
+
+  private:
+    It m_source;
+    std::vector<selection_position_t<It>> m_positions;
+};
+
+template <typename F>
+struct SelectType {
+    F f;
+};
+
 /// \endcond
 
 template <typename... Fs>
@@ -88,11 +166,36 @@ constexpr auto remove_if(F f, Fs... fs) {
     return FilterType<decltype(foo)>{std::move(foo)};
 }
 
+template <typename... Fs>
+/**
+ * @brief select - Same as ltl::filter, but the matching elements are found once, when the range is built
+ *
+ * The positions of the matching elements are stored in a vector, so the resulting range is random access and its
+ * `size()`, `back()` and `operator[]` are O(1). It is useful when a filtered range is traversed or queried several
+ * times.
+ *
+ * @code
+ *  std::vector<int> values;
+ *  auto odds = values | ltl::select(is_odd);
+ *  use(odds.size(), odds.back(), odds[odds.size() / 2]);
+ * @endcode
+ *
+ * Note : The range keeps iterators of the source: it must not be modified while the range is used.
+ * @param fs
+ */
+constexpr auto select(Fs... fs) {
+    auto foo = compose(std::move(fs)...);
+    return SelectType<decltype(foo)>{std::move(foo)};
+}
+
 /// \cond
 
 template <typename F>
 struct is_chainable_operation<FilterType<F>> : true_t {};
 
+template <typename F>
+struct is_chainable_operation<SelectType<F>> : true_t {};
+
 template <typename T1, typename F, requires_f(IsIterableRef<T1>)>
 constexpr decltype(auto) operator|(T1 &&a, FilterType<F> b) {
     using std::begin;
@@ -102,6 +205,24 @@ constexpr decltype(auto) operator|(T1 &&a, FilterType<F> b) {
                  FilterIterator<it, decltype(b.f)>{end(FWD(a)), begin(FWD(a)), end(FWD(a)), b.f}};
 }
 
+// filter(p1) | filter(p2) is fused into filter(p1 && p2): only one FilterIterator walks the source
+template <typename It, typename P, typename F>
+constexpr decltype(auto) operator|(Range<FilterIterator<It, P>> a, FilterType<F> b) {
+    auto first = a.begin();
+    auto both = [p = *first.m_function.m_function, f = std::move(b.f)](const auto &x) {
+        return ltl::fast_invoke(p, x) && ltl::fast_invoke(f, x);
+    };
+    return Range<It>{std::move(first.m_it), a.end().m_it} | FilterType<decltype(both)>{std::move(both)};
+}
+
+template <typename T1, typename F, requires_f(IsIterableRef<T1>)>
+decltype(auto) operator|(T1 &&a, SelectType<F> b) {
+    using std::begin;
+    using std::end;
+    using it = decltype(begin(FWD(a)));
+    return SelectRange<it>{begin(FWD(a)), end(FWD(a)), b.f};
+}
+
 /// \endcond
 
 /// @}
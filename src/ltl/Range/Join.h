@@ -3,11 +3,14 @@
  */
 #pragma once
 
+#include <memory>
 #include <optional>
+#include <string_view>
 
 #include "Range.h"
 #include "Reverse.h"
 #include "BaseIterator.h"
+#include "Segmented.h"
 
 namespace ltl {
 
@@ -18,15 +21,41 @@ namespace ltl {
 
 /// \cond
 
+namespace details {
+template <typename It>
+struct pusher;
+
+// The iterators of a borrowed range do not depend on the range object: they stay valid once it is destroyed
+template <typename T>
+struct is_borrowed_range : bool_t<std::is_lvalue_reference_v<T>> {};
+
+template <typename It>
+struct is_borrowed_range<Range<It>> : true_t {};
+
+template <typename Char, typename Traits>
+struct is_borrowed_range<std::basic_string_view<Char, Traits>> : true_t {};
+} // namespace details
+
+// The iterators of the current container are cached, so the dereference and the increment do not walk it again. The
+// containers given by value are shared between the copies of the iterator to keep these iterators valid, and the
+// position in the container is counted to compare iterators that do not share it
 template <typename It>
 class JoinIterator :
     public BaseIterator<JoinIterator<It>, It>,
     public WithSentinel<It>,
     public IteratorOperationByIterating<JoinIterator<It>> {
+    template <typename>
+    friend struct details::pusher;
+
+    template <typename, typename>
+    friend struct details::segmented_iterator;
+
   public:
     using Container = typename std::iterator_traits<It>::reference;
     using ContainerIterator = decltype(std::declval<Container>().begin());
-    using ContainerPtr = AsPointer<Container>;
+    static constexpr bool owns_container = !details::is_borrowed_range<Container>::value;
+    using ContainerHolder = std::conditional_t<owns_container, std::shared_ptr<ltl::remove_cvref_t<Container>>,
+                                               std::optional<AsPointer<Container>>>;
 
     using reference = typename std::iterator_traits<ContainerIterator>::reference;
     DECLARE_EVERYTHING_BUT_REFERENCE(get_iterator_category<It>);
@@ -41,59 +70,136 @@ class JoinIterator :
             ++this->m_it;
     }
 
-    JoinIterator &operator++() noexcept {
+    JoinIterator &operator++() {
         if (m_current != m_end) {
             ++m_current;
+            ++m_index;
         }
 
-        if (m_current == m_end) {
-            assert(this->m_it != this->m_sentinelEnd);
-            do {
-                ++this->m_it;
-            } while (!assignContainerValues());
-        }
+        if (m_current == m_end)
+            nextContainer();
         return *this;
     }
 
-    JoinIterator &operator--() noexcept {
-        if (m_current == 0) {
+    JoinIterator &operator--() {
+        if (m_index == 0) {
             assert(this->reverse(this->m_it) != this->m_sentinelBegin);
             do {
                 --this->m_it;
             } while (!assignContainerValues());
-            m_current = m_end - 1;
-        } else {
-            --m_current;
+            using std::begin;
+            m_index = std::distance(begin(container()), m_end);
+            m_current = m_end;
         }
+        --m_current;
+        --m_index;
         return *this;
     }
 
-    reference operator*() const { return *std::next(begin(**const_cast<JoinIterator &>(*this).m_ptr), m_current); }
+    reference operator*() const { return *m_current; }
 
     friend bool operator==(const JoinIterator &a, const JoinIterator &b) noexcept {
         if (a.m_it == b.m_it) {
             if (a.m_it == a.m_sentinelEnd)
                 return true;
-            return a.m_current == b.m_current;
+            return a.m_index == b.m_index;
         }
         return false;
     }
 
   private:
+    decltype(auto) container() {
+        if constexpr (owns_container)
+            return *m_container;
+        else
+            return **m_container;
+    }
+
+    // The target is in the current container or in one of the next ones
+    void moveTo(const ContainerIterator &target) {
+        while (m_end <= target)
+            nextContainer();
+        m_index += target - m_current;
+        m_current = target;
+    }
+
+    void nextContainer() {
+        assert(this->m_it != this->m_sentinelEnd);
+        do {
+            ++this->m_it;
+        } while (!assignContainerValues());
+    }
+
     [[nodiscard]] bool assignContainerValues() {
         if (this->m_it == this->m_sentinelEnd) {
             return true;
         }
-        m_ptr.emplace(*this->m_it);
-        m_current = 0;
-        m_end = std::distance(begin(**m_ptr), end(**m_ptr));
-        return m_end > 0;
+        if constexpr (owns_container) {
+            using value_type = ltl::remove_cvref_t<Container>;
+            // The container of the previous position is reused when no other iterator shares it
+            if constexpr (std::is_move_assignable_v<value_type>) {
+                if (m_container.use_count() == 1)
+                    *m_container = *this->m_it;
+                else
+                    m_container = std::make_shared<value_type>(*this->m_it);
+            } else {
+                m_container = std::make_shared<value_type>(*this->m_it);
+            }
+        } else {
+            m_container.emplace(*this->m_it);
+        }
+        using std::begin;
+        using std::end;
+        m_current = begin(container());
+        m_end = end(container());
+        m_index = 0;
+        return m_current != m_end;
     }
 
-    std::optional<ContainerPtr> m_ptr;
-    long long int m_current{0};
-    long long int m_end{0};
+    ContainerHolder m_container{};
+    ContainerIterator m_current{};
+    ContainerIterator m_end{};
+    long long int m_index{0};
+};
+
+namespace details {
+// Each container of the join is a segment. When the containers are adjacent in their source and random access, the
+// whole join is one segment of the source
+template <typename It>
+struct segmented_iterator<JoinIterator<It>> {
+    using Inner = typename JoinIterator<It>::ContainerIterator;
+    static constexpr bool is_segmented = true;
+
+    template <typename F>
+    static JoinIterator<It> for_each_segment(JoinIterator<It> first, const JoinIterator<It> &last, F &&f) {
+        if constexpr (has_adjacent_ranges<It>::value && IsRandomAccessIterator<Inner>) {
+            if (first == last)
+                return first;
+            const Inner end = last.m_it == last.m_sentinelEnd ? last.m_it.m_it : last.m_current;
+            Inner stop = f(first.m_current, end);
+            if (stop == end)
+                return last;
+            first.moveTo(stop);
+            return first;
+        } else {
+            while (first != last) {
+                const bool isLast = first.m_it == last.m_it;
+                const Inner end = isLast ? std::next(first.m_current, last.m_index - first.m_index) : first.m_end;
+                Inner stop = f(first.m_current, end);
+                if (stop != end) {
+                    first.m_index += std::distance(first.m_current, stop);
+                    first.m_current = std::move(stop);
+                    return first;
+                }
+                if (isLast)
+                    return last;
+                first.nextContainer();
+            }
+            return first;
+        }
+    }
 };
+} // namespace details
 
 struct join_t {};
 
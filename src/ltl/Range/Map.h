@@ -7,6 +7,7 @@
 #include "ltl/functional.h"
 #include "ltl/optional_type.h"
 
+#include "Filter.h"
 #include "Join.h"
 #include "Range.h"
 
@@ -29,6 +30,8 @@ struct MapIterator :
 
     DECLARE_EVERYTHING_BUT_REFERENCE(get_iterator_category<It>);
 
+    static constexpr bool is_sized = IsSizedIterator<It>;
+
     MapIterator() = default;
 
     MapIterator(It current, Function f) noexcept :
@@ -36,6 +39,10 @@ struct MapIterator :
         WithFunction<Function>{std::move(f)} {}
 
     reference operator*() const { return this->m_function(*this->m_it); }
+
+    std::optional<details::size_hint_t> size_hint(const MapIterator &last) const {
+        return details::size_hint(this->m_it, last.m_it);
+    }
 };
 
 template <typename F>
@@ -126,6 +133,25 @@ constexpr decltype(auto) operator|(T1 &&a, MapType<F> b) {
                  MapIterator<it, decltype(b.f)>{end(FWD(a)), b.f}};
 }
 
+// map(f) | map(g) is fused into map(compose(f, g))
+template <typename It, typename F, typename G>
+constexpr decltype(auto) operator|(Range<MapIterator<It, F>> a, MapType<G> b) {
+    auto first = a.begin();
+    auto f = compose(*first.m_function.m_function, std::move(b.f));
+    return Range<It>{std::move(first.m_it), a.end().m_it} | MapType<decltype(f)>{std::move(f)};
+}
+
+// map(f) | filter(p) is reordered into filter(compose(f, p)) | map(f): the filter walks the source directly and can be
+// fused with a previous filter, so any chain of map and filter ends up as one filter followed by one map
+template <typename It, typename F, typename P>
+constexpr decltype(auto) operator|(Range<MapIterator<It, F>> a, FilterType<P> b) {
+    auto first = a.begin();
+    const F &f = *first.m_function.m_function;
+    auto predicate = compose(f, std::move(b.f));
+    return Range<It>{std::move(first.m_it), a.end().m_it} | FilterType<decltype(predicate)>{std::move(predicate)} |
+           MapType<F>{f};
+}
+
 template <typename T1, typename F, requires_f(IsOptional<T1>)>
 constexpr decltype(auto) operator|(T1 &&a, MapType<F> b) {
     if (a)
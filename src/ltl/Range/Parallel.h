@@ -0,0 +1,225 @@
+/**
+ * @file Parallel.h
+ */
+#pragma once
+
+#include <future>
+#include <optional>
+#include <vector>
+
+#include "ltl/thread.h"
+#include "ltl/Tuple.h"
+#include "Filter.h"
+#include "Map.h"
+
+namespace ltl {
+
+/**
+ * \defgroup Iterator The iterator group
+ * @{
+ */
+
+/**
+ * @brief The parallel_policy struct - Execution policy dispatching a pipeline over a thread pool
+ *
+ * It is used through `ltl::par`.
+ */
+struct parallel_policy {
+    /**
+     * @brief operator() - returns the same policy running on the given pool
+     *
+     * @code
+     *  ltl::thread_pool pool{4};
+     *  auto sum = values | ltl::par(pool) | ltl::map(square) | ltl::actions::sum;
+     * @endcode
+     */
+    constexpr parallel_policy operator()(thread_pool &pool) const noexcept { return parallel_policy{&pool}; }
+
+    thread_pool &pool() const noexcept { return m_pool ? *m_pool : default_thread_pool(); }
+
+    thread_pool *m_pool = nullptr;
+};
+
+/**
+ * @brief par - Run the following operations and the terminal action on a thread pool
+ *
+ * The source must be random access, or a `split_view`. Only element-wise operations (`map`, `filter`, `select`) may
+ * follow `par`.
+ * The pipeline is split into several chunks of the source, each chunk is reduced by one worker and the partial results
+ * are then combined.
+ *
+ * @code
+ *  std::vector<int> values;
+ *  auto sum = values | ltl::par | ltl::filter(is_odd) | ltl::map(square) | ltl::actions::sum;
+ *  values |= ltl::par | ltl::actions::sort;
+ * @endcode
+ */
+inline constexpr parallel_policy par{};
+
+/// \cond
+
+template <typename T>
+struct is_parallelizable_operation : false_t {};
+
+template <typename F>
+struct is_parallelizable_operation<MapType<F>> : true_t {};
+
+template <typename F>
+struct is_parallelizable_operation<FilterType<F>> : true_t {};
+
+template <typename F>
+struct is_parallelizable_operation<SelectType<F>> : true_t {};
+
+template <typename T>
+constexpr bool IsParallelizableOperation = is_parallelizable_operation<ltl::remove_cvref_t<T>>::value;
+
+// A source of ltl::par is cut in chunks given to the workers: a random access range is cut by index
+template <typename T>
+struct is_parallel_source : false_t {};
+
+template <typename T>
+constexpr bool IsParallelSource = is_parallel_source<ltl::remove_cvref_t<T>>::value;
+
+template <typename It>
+std::size_t parallel_size(const Range<It> &range) noexcept {
+    return range.size();
+}
+
+template <typename It>
+Range<It> parallel_chunk(const Range<It> &range, std::size_t first, std::size_t last) noexcept {
+    auto b = range.begin();
+    return Range<It>{b + first, b + last};
+}
+
+template <typename Source, typename... Operations>
+class ParallelView {
+    using tuple_type = ltl::tuple_t<Operations...>;
+
+  public:
+    using source_chunk_type = decltype(parallel_chunk(std::declval<const Source &>(), 0, 0));
+    using chunk_type = decltype((std::declval<source_chunk_type &>() | ... | std::declval<Operations &>()));
+    using value_type = ltl::remove_cvref_t<decltype(*begin(std::declval<chunk_type &>()))>;
+
+    ParallelView(Source source, parallel_policy policy, tuple_type operations = {}) noexcept :
+        m_source{std::move(source)}, m_policy{policy}, m_operations{std::move(operations)} {}
+
+    template <typename Operation>
+    auto add_operation(Operation operation) && {
+        return ParallelView<Source, Operations..., Operation>{std::move(m_source), m_policy,
+                                                              std::move(m_operations).push_back(std::move(operation))};
+    }
+
+    const parallel_policy &policy() const noexcept { return m_policy; }
+
+    template <typename F>
+    auto transform_chunks(F &&f) const {
+        using result_type = decltype(f(std::declval<chunk_type &>()));
+        thread_pool &pool = m_policy.pool();
+        const std::size_t n = parallel_size(m_source);
+        const std::size_t chunkCount =
+            std::max<std::size_t>(1, std::min(n, pool.size() * thread_pool::chunks_per_thread));
+
+        std::vector<std::future<result_type>> futures;
+        futures.reserve(chunkCount - 1);
+        for (std::size_t i = 0; i + 1 < chunkCount; ++i) {
+            futures.push_back(pool.submit([this, &f, i, n, chunkCount] { //
+                auto chunk = make_chunk(n * i / chunkCount, n * (i + 1) / chunkCount);
+                return f(chunk);
+            }));
+        }
+
+        // The tasks reference f: they must all be done before an exception leaves this function
+        auto lastChunk = make_chunk(n * (chunkCount - 1) / chunkCount, n);
+        std::optional<result_type> last;
+        try {
+            last.emplace(f(lastChunk));
+        } catch (...) {
+            pool.wait_all(futures);
+            throw;
+        }
+        pool.wait_all(futures);
+
+        std::vector<result_type> results;
+        results.reserve(chunkCount);
+        for (auto &future : futures)
+            results.push_back(pool.get(future));
+        results.push_back(std::move(*last));
+        return results;
+    }
+
+  private:
+    auto make_chunk(std::size_t first, std::size_t last) const {
+        auto chunk = parallel_chunk(m_source, first, last);
+        return m_operations([&chunk](const auto &...operations) { return (chunk | ... | operations); });
+    }
+
+    Source m_source;
+    parallel_policy m_policy;
+    tuple_type m_operations;
+};
+
+template <typename T1, requires_f(IsIterableRef<T1> || IsParallelSource<T1>)>
+auto operator|(T1 &&a, parallel_policy policy) {
+    if constexpr (IsParallelSource<T1>) {
+        return ParallelView<ltl::remove_cvref_t<T1>>{FWD(a), policy};
+    } else {
+        using It = decltype(begin(FWD(a)));
+        static_assert(IsRandomAccessIterator<It>, "ltl::par needs a random access source");
+        return ParallelView<Range<It>>{Range<It>{begin(FWD(a)), end(FWD(a))}, policy};
+    }
+}
+
+template <typename Source, typename... Operations, typename Operation, requires_f(IsChainableOperation<Operation>)>
+auto operator|(ParallelView<Source, Operations...> view, Operation operation) {
+    static_assert(IsParallelizableOperation<Operation>, "Only map, filter and select operations may follow ltl::par");
+    return std::move(view).add_operation(std::move(operation));
+}
+
+template <typename Source, typename... Operations, typename... Ts>
+auto operator|(ParallelView<Source, Operations...> view, tuple_t<Ts...> operations) {
+    return std::move(operations)([&view](auto &&...xs) { return (std::move(view) | ... | FWD(xs)); });
+}
+
+namespace details {
+template <typename C, typename F>
+void parallel_sort(const parallel_policy &policy, C &c, F compare) {
+    auto first = begin(c);
+    static_assert(IsRandomAccessIterator<decltype(first)>, "ltl::par needs a random access source");
+    thread_pool &pool = policy.pool();
+    const std::size_t n = std::distance(first, end(c));
+    const std::size_t chunkCount = std::max<std::size_t>(1, std::min(n, pool.size()));
+
+    std::vector<std::size_t> bounds;
+    for (std::size_t i = 0; i <= chunkCount; ++i)
+        bounds.push_back(n * i / chunkCount);
+
+    std::vector<std::future<void>> futures;
+    for (std::size_t i = 0; i < chunkCount; ++i) {
+        auto b = first + bounds[i];
+        auto e = first + bounds[i + 1];
+        futures.push_back(pool.submit([b, e, &compare] { std::sort(b, e, compare); }));
+    }
+    pool.wait_all(futures);
+    for (auto &future : futures)
+        pool.get(future);
+
+    for (std::size_t width = 1; width < chunkCount; width *= 2) {
+        futures.clear();
+        for (std::size_t i = 0; i + width < chunkCount; i += 2 * width) {
+            auto b = first + bounds[i];
+            auto m = first + bounds[i + width];
+            auto e = first + bounds[std::min(i + 2 * width, chunkCount)];
+            futures.push_back(pool.submit([b, m, e, &compare] { std::inplace_merge(b, m, e, compare); }));
+        }
+        pool.wait_all(futures);
+        for (auto &future : futures)
+            pool.get(future);
+    }
+}
+} // namespace details
+
+/// \endcond
+
+/// @}
+
+} // namespace ltl
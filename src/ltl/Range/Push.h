@@ -0,0 +1,181 @@
+/**
+ * @file Push.h
+ */
+#pragma once
+
+#include "Filter.h"
+#include "Join.h"
+#include "Map.h"
+#include "Zip.h"
+
+namespace ltl {
+
+/**
+ * \defgroup Iterator The iterator group
+ * @{
+ */
+
+/// \cond
+
+namespace details {
+
+/**
+ * Internal iteration: instead of pulling the elements through every layer of iterators, the loop runs over the source
+ * and each filter or map layer becomes a callback wrapping the sink. The compiler then sees only one loop over the
+ * source, without the sentinel comparisons of the filter iterators.
+ *
+ * push(first, last, sink) calls sink on every element until it returns false and returns the iterator on the element
+ * that stopped it (or last). push_all(first, last, sink) calls sink on every element: the loop has no early exit, so
+ * the compiler may vectorize it.
+ */
+template <typename It>
+struct pusher {
+    static constexpr bool is_pushable = IsContiguousIterator<It>;
+
+    template <typename Sink>
+    static It push(It first, const It &last, Sink &&sink) {
+        for (; first != last; ++first) {
+            if (!sink(*first))
+                break;
+        }
+        return first;
+    }
+
+    template <typename Sink>
+    static void push_all(It first, const It &last, Sink &&sink) {
+        for (; first != last; ++first)
+            sink(*first);
+    }
+};
+
+template <typename It, typename Predicate>
+struct pusher<FilterIterator<It, Predicate>> {
+    static constexpr bool is_pushable = pusher<It>::is_pushable;
+
+    template <typename Sink>
+    static FilterIterator<It, Predicate> push(FilterIterator<It, Predicate> first,
+                                              const FilterIterator<It, Predicate> &last, Sink &&sink) {
+        const auto &predicate = first.m_function;
+        first.m_it = pusher<It>::push(first.m_it, last.m_it, [&predicate, &sink](auto &&x) {
+            return !ltl::fast_invoke(predicate, x) || sink(FWD(x));
+        });
+        return first;
+    }
+
+    template <typename Sink>
+    static void push_all(const FilterIterator<It, Predicate> &first, const FilterIterator<It, Predicate> &last,
+                         Sink &&sink) {
+        const auto &predicate = first.m_function;
+        pusher<It>::push_all(first.m_it, last.m_it, [&predicate, &sink](auto &&x) {
+            if (ltl::fast_invoke(predicate, x))
+                sink(FWD(x));
+        });
+    }
+};
+
+template <typename It, typename Function>
+struct pusher<MapIterator<It, Function>> {
+    static constexpr bool is_pushable = pusher<It>::is_pushable;
+
+    template <typename Sink>
+    static MapIterator<It, Function> push(MapIterator<It, Function> first, const MapIterator<It, Function> &last,
+                                          Sink &&sink) {
+        const auto &function = first.m_function;
+        first.m_it = pusher<It>::push(first.m_it, last.m_it, [&function, &sink](auto &&x) {
+            return sink(ltl::fast_invoke(function, FWD(x)));
+        });
+        return first;
+    }
+
+    template <typename Sink>
+    static void push_all(const MapIterator<It, Function> &first, const MapIterator<It, Function> &last, Sink &&sink) {
+        const auto &function = first.m_function;
+        pusher<It>::push_all(first.m_it, last.m_it,
+                             [&function, &sink](auto &&x) { sink(ltl::fast_invoke(function, FWD(x))); });
+    }
+};
+
+// The zipped arrays are read with one index, as a plain loop over several arrays (structure of arrays) would do
+template <typename... Its>
+struct pusher<ZipIterator<Its...>> {
+    static constexpr bool is_pushable = (IsContiguousIterator<Its> && ...);
+
+    template <typename Sink>
+    static ZipIterator<Its...> push(ZipIterator<Its...> first, const ZipIterator<Its...> &last, Sink &&sink) {
+        const long long int n = last - first;
+        long long int i = 0;
+        first.m_it([&](const auto &...xs) {
+            for (; i < n; ++i) {
+                if (!sink(typename ZipIterator<Its...>::reference{xs[i]...}))
+                    break;
+            }
+        });
+        first += i;
+        return first;
+    }
+
+    template <typename Sink>
+    static void push_all(const ZipIterator<Its...> &first, const ZipIterator<Its...> &last, Sink &&sink) {
+        const long long int n = last - first;
+        first.m_it([&](const auto &...xs) {
+            for (long long int i = 0; i < n; ++i)
+                sink(typename ZipIterator<Its...>::reference{xs[i]...});
+        });
+    }
+};
+
+// Each container is pushed as a whole, so the inner loop runs over a contiguous container without going back through
+// the outer iterator
+template <typename It>
+struct pusher<JoinIterator<It>> {
+    using Inner = typename JoinIterator<It>::ContainerIterator;
+    static constexpr bool is_pushable = pusher<Inner>::is_pushable;
+
+    template <typename Sink>
+    static JoinIterator<It> push(JoinIterator<It> first, const JoinIterator<It> &last, Sink &&sink) {
+        return for_each_segment(std::move(first), last, [&sink](Inner first, const Inner &last) {
+            return pusher<Inner>::push(first, last, sink);
+        });
+    }
+
+    template <typename Sink>
+    static void push_all(JoinIterator<It> first, const JoinIterator<It> &last, Sink &&sink) {
+        for_each_segment(std::move(first), last, [&sink](Inner first, const Inner &last) {
+            pusher<Inner>::push_all(first, last, sink);
+            return last;
+        });
+    }
+};
+
+template <typename It>
+constexpr bool IsPushable = pusher<It>::is_pushable;
+
+template <typename It, typename Sink>
+It push(It first, const It &last, Sink &&sink) {
+    return pusher<It>::push(std::move(first), last, FWD(sink));
+}
+
+template <typename C, typename F>
+auto push_find_if(C &c, F &&f) {
+    using std::begin;
+    using std::end;
+    return push(begin(c), end(c), [&f](auto &&x) { return !ltl::fast_invoke(f, x); });
+}
+
+template <typename C, typename T, typename F>
+T push_accumulate(const C &c, T init, F &&f) {
+    using std::begin;
+    using std::end;
+    auto first = begin(c);
+    pusher<decltype(first)>::push_all(first, end(c),
+                                      [&init, &f](auto &&x) { init = ltl::invoke(f, std::move(init), FWD(x)); });
+    return init;
+}
+
+} // namespace details
+
+/// \endcond
+
+/// @}
+
+} // namespace ltl
@@ -0,0 +1,263 @@
+/**
+ * @file RadixSort.h
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ltl/thread.h"
+#include "ltl/invoke.h"
+#include "BaseIterator.h"
+
+namespace ltl {
+
+/// \cond
+
+namespace details {
+
+template <typename T>
+constexpr bool IsRadixKey = (std::is_integral_v<T> && !std::is_same_v<T, bool>) ||
+                            (std::is_floating_point_v<T> && std::numeric_limits<T>::is_iec559 &&
+                             (sizeof(T) == 4 || sizeof(T) == 8));
+
+// Maps a key to an unsigned integer with the same order
+template <typename T>
+auto radix_key(T x) noexcept {
+    if constexpr (std::is_floating_point_v<T>) {
+        using unsigned_type = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+        constexpr unsigned_type sign = unsigned_type(1) << (sizeof(T) * 8 - 1);
+        unsigned_type bits;
+        std::memcpy(&bits, &x, sizeof(T));
+        return (bits & sign) ? unsigned_type(~bits) : unsigned_type(bits | sign);
+    } else {
+        using unsigned_type = std::make_unsigned_t<T>;
+        constexpr unsigned_type sign = std::is_signed_v<T> ? unsigned_type(1) << (sizeof(T) * 8 - 1) : 0;
+        return unsigned_type(static_cast<unsigned_type>(x) ^ sign);
+    }
+}
+
+template <typename It, typename Key>
+using radix_key_t = ltl::remove_cvref_t<decltype(ltl::fast_invoke(std::declval<Key &>(), *std::declval<It>()))>;
+
+template <typename It, typename Key>
+constexpr bool IsRadixSortable =
+    IsRandomAccessIterator<It> && IsRadixKey<radix_key_t<It, Key>> &&
+    std::is_default_constructible_v<typename std::iterator_traits<It>::value_type> &&
+    std::is_move_assignable_v<typename std::iterator_traits<It>::value_type>;
+
+// Below this size, std::sort is faster than the radix sort
+constexpr std::size_t radix_sort_min_size = 1024;
+
+// The key of an element with its position, sorted instead of the element when it is large
+template <typename Unsigned>
+struct radix_entry {
+    Unsigned key;
+    std::size_t index;
+};
+
+enum class radix_layout { none, direct, indexed };
+
+/**
+ * Chooses how n elements of ElementSize bytes are sorted when their keys differ in passes bytes: std::sort, radix
+ * passes over the elements, or radix passes over their keys and positions before moving every element once.
+ *
+ * The costs are the times measured per element, in nanoseconds on one core. std::sort moves each element about
+ * log2(n) times, a pass moves it once, and the final permutation is bound by cache misses whatever the element size.
+ */
+template <std::size_t ElementSize, std::size_t EntrySize>
+constexpr radix_layout choose_radix_layout(std::size_t n, std::size_t passes) noexcept {
+    constexpr std::size_t elementWords = (ElementSize + 7) / 8;
+    constexpr std::size_t entryWords = (EntrySize + 7) / 8;
+    constexpr std::size_t permutationCost = 200;
+
+    std::size_t log2n = 0;
+    while ((std::size_t(1) << log2n) < n)
+        ++log2n;
+    const std::size_t sortCost = log2n * (11 + elementWords) / 2;
+    const std::size_t directCost = passes * (10 + 5 * elementWords);
+    const std::size_t indexedCost = passes * (10 + 5 * entryWords) + permutationCost;
+
+    if (std::min(directCost, indexedCost) >= sortCost)
+        return radix_layout::none;
+    return directCost <= indexedCost ? radix_layout::direct : radix_layout::indexed;
+}
+
+/**
+ * The LSD passes of the radix sort, one per byte of the key in bytes. first holds the sorted elements at the end.
+ *
+ * for_each_chunk(f) calls f(chunk, b, e) on every chunk of [0, n), on the workers of the pool when there is one.
+ */
+template <typename It, typename KeyOf, typename ForEachChunk>
+void radix_passes(It first, std::size_t n, const std::vector<std::size_t> &bytes, const KeyOf &keyOf,
+                  std::size_t chunkCount, const ForEachChunk &for_each_chunk) {
+    using value_type = typename std::iterator_traits<It>::value_type;
+    using counts_type = std::array<std::size_t, 256>;
+
+    auto digit = [&keyOf](const auto &x, std::size_t byte) { return std::size_t(keyOf(x) >> (byte * 8)) & 0xFF; };
+
+    std::vector<counts_type> counts(chunkCount);
+    // Without a pool, the counts of every pass are computed in the same read
+    std::vector<counts_type> allCounts(chunkCount == 1 ? bytes.size() : 0);
+    if (chunkCount == 1) {
+        for (std::size_t j = 0; j < n; ++j) {
+            for (std::size_t i = 0; i < bytes.size(); ++i)
+                ++allCounts[i][digit(first[j], bytes[i])];
+        }
+    }
+
+    std::vector<value_type> buffer(n);
+    bool inBuffer = false;
+    for (std::size_t pass = 0; pass < bytes.size(); ++pass) {
+        const std::size_t byte = bytes[pass];
+        auto move_elements = [&](auto source, auto destination) {
+            if (chunkCount == 1) {
+                counts[0] = allCounts[pass];
+            } else {
+                for_each_chunk([&](std::size_t chunk, std::size_t b, std::size_t e) {
+                    counts[chunk].fill(0);
+                    for (std::size_t i = b; i < e; ++i)
+                        ++counts[chunk][digit(source[i], byte)];
+                });
+            }
+
+            std::size_t offset = 0;
+            for (std::size_t d = 0; d < 256; ++d) {
+                for (auto &count : counts)
+                    count[d] = std::exchange(offset, offset + count[d]);
+            }
+
+            for_each_chunk([&](std::size_t chunk, std::size_t b, std::size_t e) {
+                auto &offsets = counts[chunk];
+                for (std::size_t i = b; i < e; ++i)
+                    destination[offsets[digit(source[i], byte)]++] = std::move(source[i]);
+            });
+        };
+
+        if (inBuffer)
+            move_elements(buffer.begin(), first);
+        else
+            move_elements(first, buffer.begin());
+        inBuffer = !inBuffer;
+    }
+
+    if (inBuffer)
+        std::move(buffer.begin(), buffer.end(), first);
+}
+
+/**
+ * LSD radix sort, one byte of the key per pass. It is stable and needs a buffer as large as the range.
+ *
+ * A first read finds the bytes that differ between the keys, the other ones need no pass. If there are still too many
+ * passes for the size of the range, nothing is done and false is returned: a comparison sort is then faster.
+ *
+ * The large elements are not moved at each pass: their keys are sorted with their positions, then every element is
+ * moved once to its place (see choose_radix_layout).
+ *
+ * With a pool, every pass is split in chunks: each worker counts the bytes of its chunk, then moves its elements at
+ * the offsets computed from all the counts.
+ */
+template <typename It, typename Key>
+bool radix_sort(It first, It last, Key &key, thread_pool *pool = nullptr) {
+    using value_type = typename std::iterator_traits<It>::value_type;
+    using unsigned_type = decltype(radix_key(ltl::fast_invoke(key, *first)));
+    using entry_type = radix_entry<unsigned_type>;
+
+    const std::size_t n = std::distance(first, last);
+    if (n < radix_sort_min_size)
+        return false;
+
+    const std::size_t chunkCount = pool ? std::max<std::size_t>(1, std::min(pool->size(), n / radix_sort_min_size)) : 1;
+    auto for_each_chunk = [pool, n, chunkCount](auto f) {
+        std::vector<std::future<void>> futures;
+        for (std::size_t i = 0; i + 1 < chunkCount; ++i)
+            futures.push_back(pool->submit([&f, i, n, chunkCount] { //
+                f(i, n * i / chunkCount, n * (i + 1) / chunkCount);
+            }));
+        // The tasks reference f: they must all be done before an exception leaves this function
+        try {
+            f(chunkCount - 1, n * (chunkCount - 1) / chunkCount, n);
+        } catch (...) {
+            if (pool)
+                pool->wait_all(futures);
+            throw;
+        }
+        if (pool) {
+            pool->wait_all(futures);
+            for (auto &future : futures)
+                pool->get(future);
+        }
+    };
+
+    std::vector<std::array<unsigned_type, 2>> bits(chunkCount, {unsigned_type(0), unsigned_type(~unsigned_type(0))});
+    for_each_chunk([&](std::size_t chunk, std::size_t b, std::size_t e) {
+        unsigned_type anyBits = 0;
+        unsigned_type allBits = ~unsigned_type(0);
+        for (std::size_t i = b; i < e; ++i) {
+            const unsigned_type k = radix_key(ltl::fast_invoke(key, first[i]));
+            anyBits |= k;
+            allBits &= k;
+        }
+        bits[chunk] = {anyBits, allBits};
+    });
+    unsigned_type differentBits = 0;
+    unsigned_type commonBits = ~unsigned_type(0);
+    for (const auto &[anyBits, allBits] : bits) {
+        differentBits |= anyBits;
+        commonBits &= allBits;
+    }
+    differentBits &= ~commonBits;
+
+    std::vector<std::size_t> bytes;
+    for (std::size_t byte = 0; byte < sizeof(unsigned_type); ++byte) {
+        if ((differentBits >> (byte * 8)) & 0xFF)
+            bytes.push_back(byte);
+    }
+
+    const auto layout = choose_radix_layout<sizeof(value_type), sizeof(entry_type)>(n, bytes.size());
+    if (layout == radix_layout::none)
+        return false;
+
+    if (layout == radix_layout::direct) {
+        auto keyOf = [&key](const value_type &x) { return radix_key(ltl::fast_invoke(key, x)); };
+        radix_passes(first, n, bytes, keyOf, chunkCount, for_each_chunk);
+        return true;
+    }
+
+    std::vector<entry_type> entries(n);
+    for_each_chunk([&](std::size_t, std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i < e; ++i)
+            entries[i] = {radix_key(ltl::fast_invoke(key, first[i])), i};
+    });
+    radix_passes(entries.begin(), n, bytes, [](const entry_type &entry) { return entry.key; }, chunkCount,
+                 for_each_chunk);
+
+    // Every element is moved once, following the cycles of the permutation: the index of a placed entry is its own
+    for (std::size_t i = 0; i < n; ++i) {
+        if (entries[i].index == i)
+            continue;
+        value_type moved = std::move(first[i]);
+        std::size_t j = i;
+        while (entries[j].index != i) {
+            const std::size_t next = entries[j].index;
+            first[j] = std::move(first[next]);
+            entries[j].index = j;
+            j = next;
+        }
+        first[j] = std::move(moved);
+        entries[j].index = j;
+    }
+    return true;
+}
+
+} // namespace details
+
+/// \endcond
+
+} // namespace ltl
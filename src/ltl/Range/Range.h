@@ -9,6 +9,7 @@
 #include "ltl/crtp.h"
 #include "ltl/Tuple.h"
 #include "ltl/concept.h"
+#include "BaseIterator.h"
 
 namespace ltl {
 using std::begin;
@@ -25,6 +26,44 @@ auto callEnd(R &&r) {
 }
 } // namespace details
 
+/// \cond
+namespace details {
+template <typename Container, typename = void>
+struct is_reservable : false_t {};
+
+template <typename Container>
+struct is_reservable<
+    Container,
+    std::void_t<decltype(std::declval<Container &>().reserve(std::size_t{})),
+                decltype(std::declval<Container &>().emplace_back(std::declval<typename Container::value_type>())),
+                decltype(std::declval<Container &>().shrink_to_fit())>> : true_t {};
+} // namespace details
+/// \endcond
+
+template <typename Container, typename It>
+/**
+ * @brief materialize - Builds a container from the elements between two iterators
+ *
+ * When only an upper bound of the size is known without walking the elements, like for a `filter`, the container is
+ * reserved once and filled in a single pass, instead of walking the elements once to count them. It is shrunk if less
+ * than half of the reserved elements were used. Otherwise, `Container(first, last)` is used: it allocates once and
+ * constructs the elements in place when the distance is known.
+ */
+Container materialize(It first, It last) {
+    if constexpr (details::is_reservable<Container>::value) {
+        if (auto hint = details::size_hint(first, last); hint && !hint->exact) {
+            Container container;
+            container.reserve(hint->size);
+            for (; first != last; ++first)
+                container.emplace_back(*first);
+            if (container.size() < container.capacity() / 2)
+                container.shrink_to_fit();
+            return container;
+        }
+    }
+    return Container(std::move(first), std::move(last));
+}
+
 template <typename Derived>
 class AbstractRange {
     ENABLE_CRTP(Derived)
@@ -34,7 +73,7 @@ class AbstractRange {
     std::size_t size() const noexcept { return std::distance(underlying().begin(), underlying().end()); }
 
     decltype(auto) operator[](std::size_t idx) const noexcept {
-        assert(idx < size());
+        assert(idx < underlying().size());
         return *std::next(underlying().begin(), idx);
     }
 
@@ -45,15 +84,36 @@ class AbstractRange {
 
     decltype(auto) back() const noexcept {
         assert(!empty());
-        return *std::next(underlying().begin(), std::size_t{size() - 1});
+        using It = decltype(underlying().begin());
+        if constexpr (!IsSizedIterator<It> &&
+                      std::is_base_of_v<std::bidirectional_iterator_tag, get_iterator_category<It>>) {
+            return *std::prev(underlying().end());
+        } else {
+            return *std::next(underlying().begin(), std::size_t{underlying().size() - 1});
+        }
     }
 
     template <typename T, requires_f(IsIterable<T>)>
     operator T() const noexcept {
-        return T(underlying().begin(), underlying().end());
+        return materialize<T>(underlying().begin(), underlying().end());
     }
 };
 
+/// \cond
+namespace details {
+template <typename R, typename = void>
+struct has_size_member : false_t {};
+
+template <typename R>
+struct has_size_member<R, std::void_t<decltype(std::declval<const R &>().size())>> : true_t {};
+} // namespace details
+/// \endcond
+
+// The size of a sized range is known without walking it: a container, or a range of sized iterators
+template <typename R, typename T = ltl::remove_cvref_t<R>>
+constexpr bool IsSizedRange = std::is_array_v<T> || IsSizedIterator<decltype(std::begin(std::declval<R &>()))> ||
+                              (details::has_size_member<T>::value && !std::is_base_of_v<AbstractRange<T>, T>);
+
 template <typename It>
 class Range : public AbstractRange<Range<It>> {
   public:
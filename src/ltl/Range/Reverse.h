@@ -30,6 +30,8 @@ class ReverseIterator :
 
     DECLARE_EVERYTHING_BUT_REFERENCE(std::random_access_iterator_tag);
 
+    static constexpr bool is_sized = IsSizedIterator<It>;
+
     ReverseIterator() = default;
 
     ReverseIterator(It it, It begin, bool isSentinel) noexcept :
@@ -60,6 +62,19 @@ class ReverseIterator :
         return a.m_isSentinel == b.m_isSentinel && a.m_it == b.m_it;
     }
 
+    // The sentinel is one position before the first element of the source
+    static std::size_t distance(const ReverseIterator &first, const ReverseIterator &last) {
+        return static_cast<std::size_t>(std::distance(last.m_it, first.m_it)) + last.m_isSentinel -
+               first.m_isSentinel;
+    }
+
+    void advance_by(long long int n) {
+        const long long int position =
+            static_cast<long long int>(std::distance(m_sentinelBegin, this->m_it)) - m_isSentinel - n;
+        m_isSentinel = position < 0;
+        this->m_it = std::next(m_sentinelBegin, m_isSentinel ? 0 : position);
+    }
+
   private:
     It m_sentinelBegin;
     bool m_isSentinel;
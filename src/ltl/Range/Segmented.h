@@ -0,0 +1,63 @@
+/**
+ * @file Segmented.h
+ */
+#pragma once
+
+#include <utility>
+
+#include "ltl/traits.h"
+
+namespace ltl {
+
+/**
+ * \defgroup Iterator The iterator group
+ * @{
+ */
+
+/// \cond
+
+namespace details {
+
+/**
+ * A segmented iterator walks a sequence made of several local ranges, as the containers of a join. The algorithms run
+ * one loop per local range instead of paying the bookkeeping of the segmented iterator for every element.
+ *
+ * for_each_segment(first, last, f) calls f(localFirst, localLast) on every local range between first and last, in
+ * order. f returns the local iterator where it stopped: when it is not localLast, the walk stops and for_each_segment
+ * returns the iterator on this element, else it returns last.
+ *
+ * A flat iterator, as the ones of a Range over a container, is made of only one segment.
+ */
+template <typename It, typename = void>
+struct segmented_iterator {
+    static constexpr bool is_segmented = false;
+
+    template <typename F>
+    static constexpr It for_each_segment(It first, It last, F &&f) {
+        return f(std::move(first), std::move(last));
+    }
+};
+
+template <typename It>
+constexpr bool IsSegmentedIterator = segmented_iterator<It>::is_segmented;
+
+template <typename It, typename F>
+constexpr It for_each_segment(It first, It last, F &&f) {
+    return segmented_iterator<It>::for_each_segment(std::move(first), std::move(last), FWD(f));
+}
+
+// The ranges given by an iterator with a static has_adjacent_ranges member follow each other in the source, as the
+// chunks: joining them gives back a part of the source
+template <typename It, typename = void>
+struct has_adjacent_ranges : false_t {};
+
+template <typename It>
+struct has_adjacent_ranges<It, std::void_t<decltype(It::has_adjacent_ranges)>> : bool_t<It::has_adjacent_ranges> {};
+
+} // namespace details
+
+/// \endcond
+
+/// @}
+
+} // namespace ltl
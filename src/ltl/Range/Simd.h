@@ -0,0 +1,125 @@
+/**
+ * @file Simd.h
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+#include "ltl/simd.h"
+#include "Map.h"
+
+namespace ltl {
+
+/// \cond
+
+namespace details {
+
+/**
+ * Explicitly vectorized reductions over contiguous arithmetic sources.
+ *
+ * The source is either a contiguous iterator or a map over a contiguous iterator. The kernels keep several independent
+ * vector accumulators to break the dependency chain between additions, so the elements are not added in order: it is
+ * only used when the reassociation does not change the result (integers) or when the user allows it (`sum_fast`).
+ *
+ * On x86, the widest instruction set available at runtime is used (AVX-512, AVX2, or the SSE2 baseline).
+ */
+template <typename It>
+struct simd_source {
+    static constexpr bool is_contiguous = IsContiguousIterator<It>;
+
+    static auto pointer(const It &it) noexcept { return std::addressof(*it); }
+    static auto function(const It &) noexcept {
+        return [](const auto &x) { return x; };
+    }
+};
+
+template <typename It, typename Function>
+struct simd_source<MapIterator<It, Function>> {
+    static constexpr bool is_contiguous = IsContiguousIterator<It>;
+
+    static auto pointer(const MapIterator<It, Function> &it) noexcept { return std::addressof(*it.m_it); }
+    static const auto &function(const MapIterator<It, Function> &it) noexcept { return it.m_function; }
+};
+
+template <typename T>
+constexpr bool IsSimdArithmetic = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8;
+
+template <typename It>
+constexpr bool IsSimdReducible =
+    simd_source<It>::is_contiguous &&
+    IsSimdArithmetic<ltl::remove_cvref_t<typename std::iterator_traits<It>::reference>>;
+
+constexpr std::size_t simd_accumulator_count = 4;
+
+template <std::size_t Bytes, typename T, typename F>
+LTL_SIMD_ALWAYS_INLINE auto simd_sum_kernel(T *first, T *last, const F &f) {
+    using result_type = ltl::remove_cvref_t<decltype(ltl::fast_invoke(f, *first))>;
+    constexpr std::size_t lanes = Bytes / sizeof(result_type);
+    constexpr std::size_t step = simd_accumulator_count * lanes;
+
+#if LTL_SIMD_VECTOR_EXTENSIONS
+    typedef result_type vector_type __attribute__((vector_size(Bytes)));
+    vector_type accumulators[simd_accumulator_count] = {};
+    for (; last - first >= std::ptrdiff_t(step); first += step) {
+        for (std::size_t k = 0; k < simd_accumulator_count; ++k) {
+            vector_type values;
+            for (std::size_t j = 0; j < lanes; ++j)
+                values[j] = ltl::fast_invoke(f, first[k * lanes + j]);
+            accumulators[k] += values;
+        }
+    }
+    const vector_type total = (accumulators[0] + accumulators[1]) + (accumulators[2] + accumulators[3]);
+#else
+    result_type total[lanes] = {};
+    for (; last - first >= std::ptrdiff_t(lanes); first += lanes) {
+        for (std::size_t j = 0; j < lanes; ++j)
+            total[j] += ltl::fast_invoke(f, first[j]);
+    }
+#endif
+
+    result_type result{};
+    for (std::size_t j = 0; j < lanes; ++j)
+        result += total[j];
+    for (; first != last; ++first)
+        result += ltl::fast_invoke(f, *first);
+    return result;
+}
+
+#if LTL_SIMD_RUNTIME_DISPATCH
+template <typename T, typename F>
+__attribute__((target("avx512f"))) auto simd_sum_avx512(T *first, T *last, const F &f) {
+    return simd_sum_kernel<64>(first, last, f);
+}
+
+template <typename T, typename F>
+__attribute__((target("avx2"))) auto simd_sum_avx2(T *first, T *last, const F &f) {
+    return simd_sum_kernel<32>(first, last, f);
+}
+#endif
+
+template <typename It>
+auto simd_sum(const It &first, const It &last) {
+    using result_type = ltl::remove_cvref_t<typename std::iterator_traits<It>::reference>;
+    if (first == last)
+        return result_type{};
+
+    auto *p = simd_source<It>::pointer(first);
+    auto *e = p + (last - first);
+    const auto &f = simd_source<It>::function(first);
+
+#if LTL_SIMD_RUNTIME_DISPATCH
+    if (__builtin_cpu_supports("avx512f"))
+        return static_cast<result_type>(simd_sum_avx512(p, e, f));
+    if (__builtin_cpu_supports("avx2"))
+        return static_cast<result_type>(simd_sum_avx2(p, e, f));
+#endif
+    return static_cast<result_type>(simd_sum_kernel<16>(p, e, f));
+}
+
+} // namespace details
+
+/// \endcond
+
+} // namespace ltl
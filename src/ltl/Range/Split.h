@@ -18,6 +18,21 @@ namespace ltl {
 using std::begin;
 using std::end;
 
+namespace details {
+// The chunks are the only splits whose number is known from the size of the source
+struct chunk_advance {
+    template <typename Tag, typename It>
+    It operator()(Tag, const It &beg, const It &end) const {
+        return safe_advance(beg, end, n);
+    }
+
+    std::size_t n;
+};
+
+inline auto dereference_to_range = [](auto it, auto end) { return Range<decltype(it)>{std::move(it), std::move(end)}; };
+using DereferenceToRange = decltype(dereference_to_range);
+} // namespace details
+
 template <typename It, typename AdvanceIt, typename Dereference, std::size_t ElementCountToSkip>
 class SplitIterator :
     public BaseIterator<SplitIterator<It, AdvanceIt, Dereference, ElementCountToSkip>, It>,
@@ -29,6 +44,12 @@ class SplitIterator :
         decltype(fast_invoke(std::declval<Dereference>(), std::declval<const It &>(), std::declval<const It &>()));
     DECLARE_EVERYTHING_BUT_REFERENCE(get_iterator_category<It>);
 
+    static constexpr bool is_sized = IsSizedIterator<It> && std::is_same_v<AdvanceIt, details::chunk_advance>;
+
+    // Nothing is skipped between two chunks: a join of chunks is seen as one segment of the source (see Segmented.h)
+    static constexpr bool has_adjacent_ranges =
+        ElementCountToSkip == 0 && std::is_same_v<Dereference, details::DereferenceToRange>;
+
     SplitIterator() = default;
 
     SplitIterator(It it, It sentinelBegin, It sentinelEnd, AdvanceIt advanceIt, Dereference dereference) :
@@ -49,6 +70,12 @@ class SplitIterator :
 
     reference operator*() const noexcept { return m_dereference(this->m_it, this->m_nextIterator); }
 
+    // The last chunk may be smaller than the other ones
+    static std::size_t distance(const SplitIterator &first, const SplitIterator &last) {
+        const std::size_t n = first.m_advance.m_function->n;
+        return (static_cast<std::size_t>(std::distance(first.m_it, last.m_it)) + n - 1) / n;
+    }
+
     SplitIterator &operator++() noexcept {
         m_previousIterator = this->reverse(this->m_it);
         this->m_it = safe_advance(m_nextIterator, this->m_sentinelEnd, ElementCountToSkip);
@@ -171,11 +198,6 @@ auto group_by(F &&f) {
 
 /// \cond
 
-namespace details {
-inline auto dereference_to_range = [](auto it, auto end) { return Range<decltype(it)>{std::move(it), std::move(end)}; };
-using DereferenceToRange = decltype(dereference_to_range);
-} // namespace details
-
 template <typename T1, typename T2, requires_f(IsIterableRef<T1>)>
 decltype(auto) operator|(T1 &&a, split_with_t<T2> b) {
     using it = decltype(begin(FWD(a)));
@@ -196,7 +218,7 @@ decltype(auto) operator|(T1 &&a, split_with_t<T2> b) {
 template <typename T1, requires_f(IsIterableRef<T1>)>
 decltype(auto) operator|(T1 &&a, chunk_t b) {
     using it = decltype(begin(FWD(a)));
-    auto advance = [n = b.n](auto &&, const auto &beg, const auto &end) { return safe_advance(beg, end, n); };
+    auto advance = details::chunk_advance{b.n};
     using Advance = decltype(advance);
     return Range{SplitIterator<it, Advance, details::DereferenceToRange, 0>{begin(FWD(a)), begin(FWD(a)), end(FWD(a)),
                                                                             advance, details::dereference_to_range},
@@ -0,0 +1,261 @@
+/**
+ * @file SplitView.h
+ */
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ltl/simd.h"
+#include "Parallel.h"
+#include "Range.h"
+
+namespace ltl {
+
+/**
+ * \defgroup Iterator The iterator group
+ * @{
+ */
+
+/// \cond
+
+namespace details {
+
+struct char_delimiter {
+    static constexpr bool is_overlapping = false;
+
+    std::size_t size() const noexcept { return 1; }
+
+    const char *find(const char *first, const char *last) const noexcept {
+        const void *p = std::memchr(first, static_cast<unsigned char>(c), last - first);
+        return p ? static_cast<const char *>(p) : last;
+    }
+
+    char c;
+};
+
+struct set_delimiter {
+    static constexpr bool is_overlapping = false;
+
+    std::size_t size() const noexcept { return 1; }
+
+    const char *find(const char *first, const char *last) const noexcept { return set.find(first, last); }
+
+    byte_set set;
+};
+
+struct string_delimiter {
+    string_delimiter() = default;
+
+    explicit string_delimiter(std::string_view delimiter) : string{delimiter} {
+        // "--" or "abab": two occurrences may overlap, only the leftmost one is a delimiter
+        for (std::size_t n = 1; n < string.size() && !is_overlapping; ++n)
+            is_overlapping = delimiter.substr(0, n) == delimiter.substr(string.size() - n);
+    }
+
+    std::size_t size() const noexcept { return string.size(); }
+
+    const char *find(const char *first, const char *last) const noexcept {
+        if (string.empty())
+            return last;
+        const char *data = string.data();
+        const std::size_t n = string.size();
+        while (last - first >= std::ptrdiff_t(n)) {
+            const void *p = std::memchr(first, static_cast<unsigned char>(data[0]), (last - first) - (n - 1));
+            if (!p)
+                break;
+            first = static_cast<const char *>(p);
+            if (std::memcmp(first + 1, data + 1, n - 1) == 0)
+                return first;
+            ++first;
+        }
+        return last;
+    }
+
+    std::string string;
+    bool is_overlapping = false;
+};
+
+} // namespace details
+
+template <typename Delimiter>
+class SplitViewIterator :
+    public crtp::PostIncrementable<SplitViewIterator<Delimiter>>,
+    public crtp::Comparable<SplitViewIterator<Delimiter>> {
+  public:
+    using reference = std::string_view;
+    DECLARE_EVERYTHING_BUT_REFERENCE(std::forward_iterator_tag);
+
+    SplitViewIterator() = default;
+
+    SplitViewIterator(const char *it, const char *end, Delimiter delimiter) noexcept :
+        m_it{it},                                                     //
+        m_end{end},                                                   //
+        m_delimiter{std::move(delimiter)},                            //
+        m_tokenEnd{m_it == m_end ? m_end : m_delimiter.find(m_it, m_end)} {}
+
+    reference operator*() const noexcept { return std::string_view(m_it, m_tokenEnd - m_it); }
+
+    SplitViewIterator &operator++() noexcept {
+        // A delimiter at the end of the text is not followed by an empty token
+        m_it = m_tokenEnd == m_end ? m_end : m_tokenEnd + m_delimiter.size();
+        m_tokenEnd = m_it == m_end ? m_end : m_delimiter.find(m_it, m_end);
+        return *this;
+    }
+
+    friend bool operator==(const SplitViewIterator &a, const SplitViewIterator &b) noexcept { return a.m_it == b.m_it; }
+
+  private:
+    const char *m_it = nullptr;
+    const char *m_end = nullptr;
+    Delimiter m_delimiter{};
+    const char *m_tokenEnd = nullptr;
+};
+
+template <typename Delimiter>
+class SplitViewRange : public AbstractRange<SplitViewRange<Delimiter>> {
+  public:
+    SplitViewRange(std::string_view text, Delimiter delimiter) noexcept :
+        m_text{text}, m_delimiter{std::move(delimiter)} {}
+
+    auto begin() const noexcept {
+        return SplitViewIterator<Delimiter>{m_text.data(), m_text.data() + m_text.size(), m_delimiter};
+    }
+
+    auto end() const noexcept {
+        const char *last = m_text.data() + m_text.size();
+        return SplitViewIterator<Delimiter>{last, last, m_delimiter};
+    }
+
+    std::string_view text() const noexcept { return m_text; }
+
+    /**
+     * @brief subview - returns the tokens between the byte offsets first and last of the text
+     *
+     * Both offsets are moved just after the next delimiter, so every token belongs to exactly one subview: the
+     * subviews given by consecutive offsets cover the whole view without cutting any token.
+     */
+    SplitViewRange subview(std::size_t first, std::size_t last) const noexcept {
+        const char *b = boundary(first);
+        return SplitViewRange{std::string_view(b, boundary(last) - b), m_delimiter};
+    }
+
+    /**
+     * @brief subviews - cuts the view into count subviews of about the same number of bytes
+     */
+    std::vector<SplitViewRange> subviews(std::size_t count) const {
+        std::vector<SplitViewRange> result;
+        for (std::size_t i = 0; i < count; ++i)
+            result.push_back(subview(m_text.size() * i / count, m_text.size() * (i + 1) / count));
+        return result;
+    }
+
+  private:
+    const char *boundary(std::size_t offset) const noexcept {
+        const char *first = m_text.data();
+        const char *last = first + m_text.size();
+        if (offset == 0 || offset >= m_text.size())
+            return offset == 0 ? first : last;
+
+        const char *it = first + offset;
+        if (m_delimiter.is_overlapping) {
+            // The occurrences found from the offset may not be the ones found from the beginning of the text
+            for (it = first; (it = m_delimiter.find(it, last)) != last && it < first + offset;)
+                it += m_delimiter.size();
+        } else {
+            it = m_delimiter.find(it, last);
+        }
+        return it == last ? last : it + m_delimiter.size();
+    }
+
+    std::string_view m_text;
+    Delimiter m_delimiter;
+};
+
+template <typename Delimiter>
+struct is_parallel_source<SplitViewRange<Delimiter>> : true_t {};
+
+template <typename Delimiter>
+std::size_t parallel_size(const SplitViewRange<Delimiter> &range) noexcept {
+    return range.text().size();
+}
+
+template <typename Delimiter>
+auto parallel_chunk(const SplitViewRange<Delimiter> &range, std::size_t first, std::size_t last) noexcept {
+    return range.subview(first, last);
+}
+
+template <typename Delimiter>
+struct SplitViewType {
+    Delimiter delimiter;
+};
+
+template <typename Delimiter>
+struct is_chainable_operation<SplitViewType<Delimiter>> : true_t {};
+
+/// \endcond
+
+/**
+ * @brief delimiters - a set of delimiters for split_view, any of these characters ends a token
+ *
+ * @code
+ *  std::string text = "key=value;key2=value2 key3";
+ *  // tokens = {"key", "value", "key2", "value2", "key3"}
+ *  auto tokens = text | ltl::split_view(ltl::delimiters("=; "));
+ * @endcode
+ */
+inline details::set_delimiter delimiters(std::string_view characters) noexcept {
+    return {details::byte_set{characters.begin(), characters.end()}};
+}
+
+/**
+ * @brief split_view - Split a text into std::string_view without copying anything
+ *
+ * The delimiter may be a character, a string or a set of characters built with `ltl::delimiters`. The delimiters are
+ * searched with memchr or SIMD comparisons. Like `split`, a delimiter at the end of the text does not give an empty
+ * token.
+ *
+ * The text is viewed, not copied: it must outlive the view. The view can be cut into subviews to be processed in
+ * parallel, which is what `ltl::par` does.
+ *
+ * @code
+ *  std::string log = read_log();
+ *  for (std::string_view line : log | ltl::split_view('\n'))
+ *      parse(line);
+ *
+ *  auto lines = log | ltl::split_view("\r\n");
+ *  auto errors = lines | ltl::par | ltl::filter(is_error) | ltl::map(to_one) | ltl::actions::sum;
+ * @endcode
+ */
+inline SplitViewType<details::char_delimiter> split_view(char delimiter) noexcept { return {{delimiter}}; }
+
+/// @copydoc split_view(char)
+inline SplitViewType<details::string_delimiter> split_view(std::string_view delimiter) {
+    return {details::string_delimiter{delimiter}};
+}
+
+/// @copydoc split_view(char)
+inline SplitViewType<details::set_delimiter> split_view(details::set_delimiter delimiters) noexcept {
+    return {std::move(delimiters)};
+}
+
+/// \cond
+
+template <typename T1, typename Delimiter, requires_f(IsIterableRef<T1>)>
+auto operator|(T1 &&a, SplitViewType<Delimiter> b) {
+    auto first = begin(a);
+    auto last = end(a);
+    using value_type = std::remove_cv_t<typename std::iterator_traits<decltype(first)>::value_type>;
+    static_assert(IsContiguousIterator<decltype(first)> && std::is_same_v<value_type, char>,
+                  "ltl::split_view needs a contiguous range of char");
+    const char *data = first == last ? nullptr : std::addressof(*first);
+    return SplitViewRange<Delimiter>{std::string_view(data, last - first), std::move(b.delimiter)};
+}
+
+/// \endcond
+
+/// @}
+
+} // namespace ltl
@@ -3,6 +3,8 @@
  */
 #pragma once
 
+#include <memory>
+
 #include "ltl/ltl.h"
 #include "Range.h"
 #include "BaseIterator.h"
@@ -37,6 +39,120 @@ struct DropWhileType {
     F f;
 };
 
+// The elements of an input range cannot be skipped ahead of time: they are counted, or tested, while iterating
+template <typename It>
+class TakeNIterator :
+    public BaseIterator<TakeNIterator<It>, It>,
+    public IteratorSimpleComparator<TakeNIterator<It>> {
+  public:
+    using reference = typename std::iterator_traits<It>::reference;
+    DECLARE_EVERYTHING_BUT_REFERENCE(std::input_iterator_tag);
+
+    TakeNIterator() = default;
+
+    TakeNIterator(It it, It end, std::size_t n) :
+        BaseIterator<TakeNIterator, It>{n == 0 ? end : std::move(it)}, m_end{std::move(end)}, m_n{n} {}
+
+    TakeNIterator &operator++() {
+        // The last element is not followed by another read of the underlying range
+        if (--m_n == 0)
+            this->m_it = m_end;
+        else
+            ++this->m_it;
+        return *this;
+    }
+
+    TakeNIterator &operator--() = delete;
+
+  private:
+    It m_end{};
+    std::size_t m_n = 0;
+};
+
+template <typename It, typename Predicate>
+class TakeWhileIterator :
+    public BaseIterator<TakeWhileIterator<It, Predicate>, It>,
+    public WithFunction<Predicate>,
+    public IteratorSimpleComparator<TakeWhileIterator<It, Predicate>> {
+  public:
+    using reference = typename std::iterator_traits<It>::reference;
+    DECLARE_EVERYTHING_BUT_REFERENCE(std::input_iterator_tag);
+
+    TakeWhileIterator() = default;
+
+    TakeWhileIterator(It it, It end, Predicate predicate) :
+        BaseIterator<TakeWhileIterator, It>{std::move(it)}, //
+        WithFunction<Predicate>{std::move(predicate)},      //
+        m_end{std::move(end)} {
+        stopIfFalse();
+    }
+
+    TakeWhileIterator &operator++() {
+        ++this->m_it;
+        stopIfFalse();
+        return *this;
+    }
+
+    TakeWhileIterator &operator--() = delete;
+
+  private:
+    void stopIfFalse() {
+        if (this->m_it != m_end && !this->m_function(*this->m_it))
+            this->m_it = m_end;
+    }
+
+    It m_end{};
+};
+
+// The skipped elements of an input range are read when the range is read, not when the view is built. The skip is
+// shared by all the iterators of the range, so it happens once even if begin() is called several times
+template <typename It, typename Skip>
+class DropIterator : public BaseIterator<DropIterator<It, Skip>, It> {
+  public:
+    using reference = typename std::iterator_traits<It>::reference;
+    DECLARE_EVERYTHING_BUT_REFERENCE(std::input_iterator_tag);
+
+    DropIterator() = default;
+
+    DropIterator(It it, It end) : BaseIterator<DropIterator, It>{std::move(it)}, m_end{std::move(end)} {}
+
+    DropIterator(It it, It end, Skip skip) :
+        BaseIterator<DropIterator, It>{std::move(it)},
+        m_end{std::move(end)},
+        m_skip{std::make_shared<NullableFunction<Skip>>(std::move(skip))} {}
+
+    reference operator*() const {
+        skip();
+        return *this->m_it;
+    }
+
+    DropIterator &operator++() {
+        skip();
+        ++this->m_it;
+        return *this;
+    }
+
+    DropIterator &operator--() = delete;
+
+    friend bool operator==(const DropIterator &a, const DropIterator &b) {
+        a.skip();
+        b.skip();
+        return a.m_it == b.m_it;
+    }
+
+  private:
+    void skip() const {
+        if (m_skip && m_skip->m_function) {
+            auto &self = const_cast<DropIterator &>(*this);
+            self.m_it = (*m_skip)(this->m_it, m_end);
+            m_skip->m_function.reset();
+        }
+    }
+
+    It m_end{};
+    std::shared_ptr<NullableFunction<Skip>> m_skip;
+};
+
 template <typename F>
 struct is_chainable_operation<TakeWhileType<F>> : true_t {};
 
@@ -51,31 +167,61 @@ struct is_chainable_operation<TakeNType> : true_t {};
 
 template <typename T1, requires_f(IsIterableRef<T1>)>
 constexpr decltype(auto) operator|(T1 &&a, TakeNType b) {
-    auto sentinelEnd = safe_advance(begin(FWD(a)), end(FWD(a)), b.n);
-    return Range{begin(FWD(a)), sentinelEnd};
+    using it = decltype(begin(FWD(a)));
+    if constexpr (IsForwardIterator<it>) {
+        auto sentinelEnd = safe_advance(begin(FWD(a)), end(FWD(a)), b.n);
+        return Range{begin(FWD(a)), sentinelEnd};
+    } else {
+        return Range{TakeNIterator<it>{begin(FWD(a)), end(FWD(a)), b.n}, //
+                     TakeNIterator<it>{end(FWD(a)), end(FWD(a)), 0}};
+    }
 }
 
 template <typename T1, requires_f(IsIterableRef<T1>)>
 constexpr decltype(auto) operator|(T1 &&a, DropNType b) {
-    auto sentinelBegin = safe_advance(begin(FWD(a)), end(FWD(a)), b.n);
-    return Range{sentinelBegin, end(FWD(a))};
+    using it = decltype(begin(FWD(a)));
+    if constexpr (IsForwardIterator<it>) {
+        auto sentinelBegin = safe_advance(begin(FWD(a)), end(FWD(a)), b.n);
+        return Range{sentinelBegin, end(FWD(a))};
+    } else {
+        auto skip = [n = b.n](it first, it last) { return safe_advance(std::move(first), std::move(last), n); };
+        return Range{DropIterator<it, decltype(skip)>{begin(FWD(a)), end(FWD(a)), skip},
+                     DropIterator<it, decltype(skip)>{end(FWD(a)), end(FWD(a))}};
+    }
 }
 
 template <typename T1, typename F, requires_f(IsIterableRef<T1>)>
 constexpr decltype(auto) operator|(T1 &&a, TakeWhileType<F> b) {
-    auto sentinelEnd = std::find_if_not(begin(FWD(a)), end(FWD(a)),
-                                        [b = std::move(b)](auto &&x) { //
-                                            return ltl::fast_invoke(std::move(b.f), FWD(x));
-                                        });
-    return Range{begin(FWD(a)), sentinelEnd};
+    using it = decltype(begin(FWD(a)));
+    if constexpr (IsForwardIterator<it>) {
+        auto sentinelEnd = std::find_if_not(begin(FWD(a)), end(FWD(a)),
+                                            [b = std::move(b)](auto &&x) { //
+                                                return ltl::fast_invoke(std::move(b.f), FWD(x));
+                                            });
+        return Range{begin(FWD(a)), sentinelEnd};
+    } else {
+        return Range{TakeWhileIterator<it, F>{begin(FWD(a)), end(FWD(a)), b.f}, //
+                     TakeWhileIterator<it, F>{end(FWD(a)), end(FWD(a)), b.f}};
+    }
 }
 
 template <typename T1, typename F, requires_f(IsIterableRef<T1>)>
 constexpr decltype(auto) operator|(T1 &&a, DropWhileType<F> b) {
-    auto sentinelBegin = std::find_if_not(begin(FWD(a)), end(FWD(a)), [b = std::move(b)](auto &&x) { //
-        return ltl::fast_invoke(std::move(b.f), FWD(x));
-    });
-    return Range{sentinelBegin, end(FWD(a))};
+    using it = decltype(begin(FWD(a)));
+    if constexpr (IsForwardIterator<it>) {
+        auto sentinelBegin = std::find_if_not(begin(FWD(a)), end(FWD(a)), [b = std::move(b)](auto &&x) { //
+            return ltl::fast_invoke(std::move(b.f), FWD(x));
+        });
+        return Range{sentinelBegin, end(FWD(a))};
+    } else {
+        auto skip = [f = std::move(b.f)](it first, it last) {
+            return std::find_if_not(std::move(first), std::move(last), [&f](auto &&x) { //
+                return ltl::fast_invoke(f, FWD(x));
+            });
+        };
+        return Range{DropIterator<it, decltype(skip)>{begin(FWD(a)), end(FWD(a)), std::move(skip)},
+                     DropIterator<it, decltype(skip)>{end(FWD(a)), end(FWD(a))}};
+    }
 }
 
 /// \endcond
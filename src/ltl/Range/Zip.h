@@ -18,10 +18,12 @@ namespace ltl {
 template <typename... Iterators>
 struct ZipIterator :
     BaseIterator<ZipIterator<Iterators...>, tuple_t<Iterators...>>,
-    IteratorOperationByIterating<ZipIterator<Iterators...>>,
-    IteratorSimpleComparator<ZipIterator<Iterators...>> {
+    IteratorOperationByIterating<ZipIterator<Iterators...>> {
     using reference = tuple_t<typename std::iterator_traits<Iterators>::reference...>;
 
+    // The arithmetic is done in one step when every iterator can do it
+    static constexpr bool is_sized = (IsSizedIterator<Iterators> && ...);
+
     using BaseIterator<ZipIterator, tuple_t<Iterators...>>::BaseIterator;
 
     DECLARE_EVERYTHING_BUT_REFERENCE(std::common_type_t<get_iterator_category<Iterators>...>);
@@ -39,6 +41,21 @@ struct ZipIterator :
     reference operator*() const {
         return this->m_it([](auto &&...xs) { return reference{*FWD(xs)...}; });
     }
+
+    reference operator[](long long int n) const {
+        return this->m_it([n](const auto &...xs) { return reference{xs[n]...}; });
+    }
+
+    void advance_by(long long int n) {
+        this->m_it([n](auto &...xs) { ((xs += n), ...); });
+    }
+
+    static std::size_t distance(const ZipIterator &first, const ZipIterator &last) {
+        return last.m_it[0_n] - first.m_it[0_n];
+    }
+
+    // The iterators of a zip move together: the first one is enough to know the position
+    friend bool operator==(const ZipIterator &a, const ZipIterator &b) noexcept { return a.m_it[0_n] == b.m_it[0_n]; }
 };
 
 namespace details {
@@ -66,7 +83,28 @@ class ZipRange : public AbstractRange<ZipRange<Containers...>> {
 
     auto begin() const noexcept { return m_containers(lift(details::build_begin_zip_iterator)); }
 
-    auto end() const noexcept { return m_containers(lift(details::build_end_zip_iterator)); }
+    // The end is computed from the size of the shortest container instead of walking until one of them is exhausted
+    auto end() const noexcept {
+        if constexpr ((IsSizedRange<Containers> && ...)) {
+            auto it = begin();
+            it += size();
+            return it;
+        } else {
+            return m_containers(lift(details::build_end_zip_iterator));
+        }
+    }
+
+    // The shortest container gives the size
+    std::size_t size() const noexcept {
+        if constexpr ((IsSizedRange<Containers> && ...)) {
+            return m_containers([](const auto &...containers) {
+                using std::size;
+                return std::min({static_cast<std::size_t>(size(containers))...});
+            });
+        } else {
+            return AbstractRange<ZipRange>::size();
+        }
+    }
 
   private:
     ltl::tuple_t<Containers...> m_containers;
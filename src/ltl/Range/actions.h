@@ -8,6 +8,10 @@
 #include "ltl/functional.h"
 
 #include "Taker.h"
+#include "Parallel.h"
+#include "Push.h"
+#include "RadixSort.h"
+#include "Simd.h"
 
 namespace ltl {
 
@@ -41,6 +45,25 @@ struct SortBy : AbstractModifyingAction {
     F f;
 };
 
+// Keeps the key instead of a comparator, so integral keys can be radix sorted
+template <typename Key>
+struct SortByAscending : AbstractModifyingAction {
+    SortByAscending(Key &&key) : key{std::move(key)} {}
+    Key key;
+};
+
+template <typename T>
+struct is_sort_by : false_t {};
+
+template <typename F>
+struct is_sort_by<SortBy<F>> : true_t {};
+
+template <typename Key>
+struct is_sort_by<SortByAscending<Key>> : true_t {};
+
+template <typename T>
+constexpr bool IsSortBy = is_sort_by<T>::value;
+
 template <typename D>
 struct JoinWith : AbstractAction {
     JoinWith(D &&d) : d{static_cast<D &&>(d)} {}
@@ -55,11 +78,21 @@ struct Accumulate : AbstractAction {
 };
 
 struct Sum : AbstractAction {};
+struct SumFast : AbstractAction {};
+
+template <typename Action>
+struct Parallel : AbstractModifyingAction {
+    Parallel(parallel_policy policy, Action action) : policy{policy}, action{std::move(action)} {}
+    parallel_policy policy;
+    Action action;
+};
 
 /// \endcond
 /**
  * @brief sort - action to sort an array
  *
+ * Large random access ranges of integers or floating point values are sorted with a radix sort.
+ *
  * @code
  *  std::vector<int> values;
  *  values |= ltl::actions::sort;
@@ -91,10 +124,13 @@ template <typename... Fs>
  *  std::vector<Person> persons;
  *  std::vector<Person> sorted_persons = persons | ltl::actions::sort_by_ascending(&Person::name);
  * @endcode
+ *
+ * When the key is an integer or a floating point value, large random access ranges are sorted with a radix sort.
  * @param fs
  */
 constexpr auto sort_by_ascending(Fs... fs) {
-    return sort_by(ltl::byAscending(std::move(fs)...));
+    auto key = compose(std::move(fs)...);
+    return SortByAscending<decltype(key)>{std::move(key)};
 }
 
 template <typename... Fs>
@@ -376,6 +412,20 @@ constexpr auto accumulate(T &&init, F f = F{}) {
  */
 constexpr Sum sum{};
 
+/**
+ * @brief sum_fast - Perform a sum, the additions may be done in any order
+ *
+ * On a contiguous range of arithmetic values, or a map over one, the sum is computed with SIMD instructions and
+ * several accumulators. For floating point values, the result may then differ slightly from `sum`, which adds the
+ * values from left to right. Integer sums are exact either way, `sum` already uses the same path for them.
+ *
+ * @code
+ *  std::vector<double> numbers;
+ *  auto sum = numbers | ltl::map(square) | ltl::actions::sum_fast;
+ * @endcode
+ */
+constexpr SumFast sum_fast{};
+
 /// \cond
 
 template <typename Action1, typename Action2, requires_f(IsAction<Action1> &&IsAction<Action2>)>
@@ -393,9 +443,24 @@ constexpr auto operator|(Action a, ltl::tuple_t<Actions...> b) {
     return b.push_front(std::move(a));
 }
 
+namespace details {
+template <typename C, typename Key>
+bool radix_sort_if_possible(C &c, Key &key, thread_pool *pool = nullptr) {
+    auto first = begin(c);
+    auto last = end(c);
+    if constexpr (ltl::details::IsRadixSortable<decltype(first), Key>) {
+        return ltl::details::radix_sort(first, last, key, pool);
+    } else {
+        return false;
+    }
+}
+} // namespace details
+
 template <typename C, requires_f(ltl::IsIterable<C>)>
 auto &operator|=(C &c, Sort) {
-    return ltl::sort(c);
+    if (!details::radix_sort_if_possible(c, ltl::identity))
+        ltl::sort(c);
+    return c;
 }
 
 template <typename C, typename F, requires_f(ltl::IsIterable<C>)>
@@ -403,6 +468,13 @@ auto &operator|=(C &c, SortBy<F> sortBy) {
     return ltl::sort(c, sortBy.f);
 }
 
+template <typename C, typename Key, requires_f(ltl::IsIterable<C>)>
+auto &operator|=(C &c, SortByAscending<Key> sortBy) {
+    if (!details::radix_sort_if_possible(c, sortBy.key))
+        ltl::sort(c, ltl::byAscending(sortBy.key));
+    return c;
+}
+
 template <typename C, requires_f(ltl::IsIterable<C>)>
 auto &operator|=(C &c, Unique) {
     c.erase(ltl::unique(c), end(c));
@@ -437,17 +509,35 @@ auto operator|(C &c, FindNullable<T> e) {
 
 template <typename C, typename F, requires_f(ltl::IsIterable<C>)>
 auto operator|(C &c, FindIf<F> e) {
-    return ::ltl::find_if(c, e.f);
+    if constexpr (ltl::details::IsPushable<decltype(begin(c))>) {
+        return ltl::details::push_find_if(c, e.f);
+    } else {
+        return ::ltl::find_if(c, e.f);
+    }
 }
 
 template <typename C, typename F, requires_f(ltl::IsIterable<C>)>
 auto operator|(const C &c, FindIfValue<F> e) {
-    return ::ltl::find_if_value(c, e.f);
+    if constexpr (ltl::details::IsPushable<decltype(begin(c))>) {
+        auto it = ltl::details::push_find_if(c, e.f);
+        if (it != end(c))
+            return ltl::make_optional(*it);
+        return decltype(ltl::make_optional(*it)){};
+    } else {
+        return ::ltl::find_if_value(c, e.f);
+    }
 }
 
 template <typename C, typename F, requires_f(ltl::IsIterable<C>)>
 auto operator|(C &c, FindIfPtr<F> e) {
-    return ::ltl::find_if_ptr(c, e.f);
+    if constexpr (ltl::details::IsPushable<decltype(begin(c))>) {
+        auto it = ltl::details::push_find_if(c, e.f);
+        if (it != end(c))
+            return std::addressof(*it);
+        return decltype(std::addressof(*it)){nullptr};
+    } else {
+        return ::ltl::find_if_ptr(c, e.f);
+    }
 }
 
 template <typename C, typename F, requires_f(ltl::IsIterable<C>)>
@@ -466,14 +556,118 @@ auto operator|(const C &c, JoinWith<D> d) -> ltl::remove_cvref_t<decltype(*c.beg
     }
 }
 
+// Filters and maps over a contiguous source are run with internal iteration, see Push.h
 template <typename C, typename T, typename F, requires_f(ltl::IsIterable<C>)>
 auto operator|(const C &c, Accumulate<T, F> a) {
-    return ltl::accumulate(c, FWD(a.init), a.f);
+    using it = decltype(begin(c));
+    if constexpr (std::is_same_v<F, std::plus<>> && std::is_integral_v<ltl::remove_cvref_t<T>> &&
+                  ltl::details::IsSimdReducible<it> &&
+                  std::is_integral_v<typename std::iterator_traits<it>::value_type> &&
+                  sizeof(typename std::iterator_traits<it>::value_type) >= sizeof(T)) {
+        // The sum is computed in the type of the elements, it must not overflow sooner than the left fold would
+        return static_cast<ltl::remove_cvref_t<T>>(a.init + ltl::details::simd_sum(begin(c), end(c)));
+    } else if constexpr (ltl::details::IsSegmentedIterator<it>) {
+        // Each local range is accumulated on its own, so it may use the simd path above
+        auto result = ltl::remove_cvref_t<T>{FWD(a.init)};
+        ltl::details::for_each_segment(begin(c), end(c), [&result, &a](auto first, auto last) {
+            result = Range{first, last} | Accumulate<ltl::remove_cvref_t<T>, F>{std::move(result), F{a.f}};
+            return last;
+        });
+        return result;
+    } else if constexpr (ltl::details::IsPushable<it>) {
+        return ltl::details::push_accumulate(c, ltl::remove_cvref_t<T>{FWD(a.init)}, a.f);
+    } else {
+        return ltl::accumulate(c, FWD(a.init), a.f);
+    }
 }
 
 template <typename C, requires_f(ltl::IsIterable<C>)>
 auto operator|(const C &c, Sum) {
-    return ltl::accumulate(c, ltl::remove_cvref_t<decltype(*begin(c))>{});
+    using it = decltype(begin(c));
+    using value_type = ltl::remove_cvref_t<decltype(*begin(c))>;
+    if constexpr (ltl::details::IsSimdReducible<it> && std::is_integral_v<value_type>) {
+        return ltl::details::simd_sum(begin(c), end(c));
+    } else if constexpr (ltl::details::IsSegmentedIterator<it>) {
+        // The running total is the initial value of the next segment: the floating point sum stays left to right
+        value_type result{};
+        ltl::details::for_each_segment(begin(c), end(c), [&result](auto first, auto last) {
+            result = Range{first, last} | Accumulate<value_type, std::plus<>>{std::move(result), std::plus<>{}};
+            return last;
+        });
+        return result;
+    } else if constexpr (ltl::details::IsPushable<it>) {
+        return ltl::details::push_accumulate(c, value_type{}, std::plus<>{});
+    } else {
+        return ltl::accumulate(c, value_type{});
+    }
+}
+
+template <typename C, requires_f(ltl::IsIterable<C>)>
+auto operator|(const C &c, SumFast) {
+    if constexpr (ltl::details::IsSimdReducible<decltype(begin(c))>) {
+        return ltl::details::simd_sum(begin(c), end(c));
+    } else {
+        return c | sum;
+    }
+}
+
+// Every chunk is folded from its first element and the partial results are folded with the same operation:
+// it must be associative, but it needs no identity value
+template <typename Source, typename... Operations, typename T, typename F>
+auto operator|(const ParallelView<Source, Operations...> &view, Accumulate<T, F> a) {
+    using result_type = ltl::remove_cvref_t<T>;
+    using value_type = typename ParallelView<Source, Operations...>::value_type;
+    static_assert(std::is_convertible_v<value_type, result_type>,
+                  "After ltl::par, accumulate combines the elements as results: use map to convert them before");
+    auto partials = view.transform_chunks([&a](const auto &chunk) {
+        auto first = begin(chunk);
+        auto last = end(chunk);
+        if (first == last)
+            return std::optional<result_type>{};
+        result_type init = *first;
+        return std::optional<result_type>{Range{std::next(first), last} |
+                                          Accumulate<result_type, F>{std::move(init), F{a.f}}};
+    });
+    result_type result{FWD(a.init)};
+    for (auto &partial : partials) {
+        if (partial)
+            result = ltl::invoke(a.f, std::move(result), std::move(*partial));
+    }
+    return result;
+}
+
+template <typename Source, typename... Operations>
+auto operator|(const ParallelView<Source, Operations...> &view, Sum) {
+    using value_type = typename ParallelView<Source, Operations...>::value_type;
+    auto partials = view.transform_chunks([](const auto &chunk) { return chunk | Sum{}; });
+    return ltl::accumulate(partials, value_type{});
+}
+
+template <typename Action, requires_f((std::is_same_v<Action, Sort> || IsSortBy<Action>))>
+constexpr auto operator|(parallel_policy policy, Action a) {
+    return Parallel<Action>{policy, std::move(a)};
+}
+
+template <typename C, requires_f(ltl::IsIterable<C>)>
+auto &operator|=(C &c, Parallel<Sort> sort) {
+    if (!details::radix_sort_if_possible(c, ltl::identity, &sort.policy.pool()))
+        ltl::details::parallel_sort(sort.policy, c, std::less<>{});
+    return c;
+}
+
+template <typename C, typename Key, requires_f(ltl::IsIterable<C>)>
+auto &operator|=(C &c, Parallel<SortByAscending<Key>> sort) {
+    auto &key = sort.action.key;
+    if (!details::radix_sort_if_possible(c, key, &sort.policy.pool()))
+        ltl::details::parallel_sort(sort.policy, c, ltl::byAscending(key));
+    return c;
+}
+
+template <typename C, typename F, requires_f(ltl::IsIterable<C>)>
+auto &operator|=(C &c, Parallel<SortBy<F>> sort) {
+    auto &f = sort.action.f;
+    ltl::details::parallel_sort(sort.policy, c, [&f](auto &&...xs) { return ltl::fast_invoke(f, FWD(xs)...); });
+    return c;
 }
 
 template <typename C, typename Action, requires_f(ltl::IsIterable<C> &&IsModifyingAction<Action>)>
@@ -0,0 +1,169 @@
+/**
+ * @file generator.h
+ */
+#pragma once
+
+#include "ltl/coroutine_helpers.h"
+
+#if LTL_COROUTINE
+
+#include <exception>
+#include <memory>
+
+#include "Range.h"
+#include "BaseIterator.h"
+
+namespace ltl {
+
+/**
+ * \defgroup Iterator The iterator group
+ * @{
+ */
+
+template <typename T>
+class generator;
+
+/// \cond
+
+template <typename T>
+class GeneratorIterator :
+    public crtp::PostIncrementable<GeneratorIterator<T>>,
+    public crtp::Comparable<GeneratorIterator<T>> {
+    using handle_type = std::coroutine_handle<typename generator<T>::promise_type>;
+
+  public:
+    using reference = const ltl::remove_cvref_t<T> &;
+    DECLARE_EVERYTHING_BUT_REFERENCE(std::input_iterator_tag);
+
+    GeneratorIterator() = default;
+    explicit GeneratorIterator(handle_type handle) noexcept : m_handle{handle} {}
+
+    reference operator*() const noexcept { return *m_handle.promise().m_value; }
+    pointer operator->() const noexcept { return pointer{**this}; }
+
+    GeneratorIterator &operator++() {
+        m_handle.resume();
+        m_handle.promise().rethrow_if_exception();
+        return *this;
+    }
+
+    // All the iterators of a generator share its position: only the end of the sequence can be compared
+    friend bool operator==(const GeneratorIterator &a, const GeneratorIterator &b) noexcept {
+        return a.done() == b.done();
+    }
+
+  private:
+    bool done() const noexcept { return !m_handle || m_handle.done(); }
+
+    handle_type m_handle{};
+};
+
+/// \endcond
+
+/**
+ * @brief generator - A lazy range of the values yielded by a coroutine
+ *
+ * The sequence stops when the coroutine returns: unlike `ltl::seq` and `ltl::end_seq`, no exception is thrown. The
+ * coroutine starts when the range is iterated for the first time, and the frames are recycled in a thread local cache,
+ * so short sequences do not allocate.
+ *
+ * The range is single pass: every iterator shares the position of the coroutine. It composes with the views (`filter`,
+ * `map`, `take_n`, `take_while`, `drop_n`...) and the actions. An exception thrown by the coroutine is rethrown while
+ * iterating.
+ *
+ * @code
+ *  ltl::generator<int> fibonacci() {
+ *      int a = 0, b = 1;
+ *      while (true) {
+ *          co_yield a;
+ *          a = std::exchange(b, a + b);
+ *      }
+ *  }
+ *
+ *  ltl::generator<int> countdown(int n) {
+ *      while (n > 0)
+ *          co_yield n--;
+ *  }
+ *
+ *  // values = [0, 2, 8, 34, 144]
+ *  std::vector<int> values = fibonacci() | ltl::filter(is_even) | ltl::take_n(5);
+ *  int total = countdown(10) | ltl::actions::sum;
+ * @endcode
+ */
+template <typename T>
+class generator : public AbstractRange<generator<T>> {
+  public:
+    using value_type = ltl::remove_cvref_t<T>;
+
+    class promise_type : public recycled_frame {
+        friend class GeneratorIterator<T>;
+        friend class generator;
+
+      public:
+        generator get_return_object() noexcept {
+            return generator{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+
+        // The yielded value lives in the frame of the coroutine until it is resumed
+        std::suspend_always yield_value(const value_type &value) noexcept {
+            m_value = std::addressof(value);
+            return {};
+        }
+
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { m_exception = std::current_exception(); }
+
+        // co_await is forbidden in a generator
+        template <typename U>
+        std::suspend_never await_transform(U &&) = delete;
+
+      private:
+        void rethrow_if_exception() {
+            if (m_exception)
+                std::rethrow_exception(std::exchange(m_exception, nullptr));
+        }
+
+        const value_type *m_value = nullptr;
+        std::exception_ptr m_exception;
+    };
+
+    generator() noexcept = default;
+    generator(generator &&other) noexcept :
+        m_handle{std::exchange(other.m_handle, nullptr)}, m_started{other.m_started} {}
+
+    generator &operator=(generator other) noexcept {
+        std::swap(m_handle, other.m_handle);
+        std::swap(m_started, other.m_started);
+        return *this;
+    }
+
+    ~generator() {
+        if (m_handle)
+            m_handle.destroy();
+    }
+
+    GeneratorIterator<T> begin() const {
+        if (m_handle && !m_started) {
+            m_started = true;
+            m_handle.resume();
+            m_handle.promise().rethrow_if_exception();
+        }
+        return GeneratorIterator<T>{m_handle};
+    }
+
+    GeneratorIterator<T> end() const noexcept { return {}; }
+
+  private:
+    explicit generator(std::coroutine_handle<promise_type> handle) noexcept : m_handle{handle} {}
+
+    std::coroutine_handle<promise_type> m_handle{};
+    mutable bool m_started = false;
+};
+
+/// @}
+
+} // namespace ltl
+
+#endif
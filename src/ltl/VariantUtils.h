@@ -6,7 +6,12 @@
 #include "functional.h"
 #include "traits.h"
 #include "fast.h"
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
 #include <memory>
+#include <memory_resource>
+#include <new>
 #include <variant>
 
 namespace ltl {
@@ -16,14 +21,100 @@ namespace ltl {
  *@{
  */
 
+/// \cond
+
+namespace details {
+[[noreturn]] inline void unreachable() noexcept {
+#if defined(__GNUC__)
+    __builtin_unreachable();
+#elif defined(_MSC_VER)
+    __assume(false);
+#else
+    std::abort();
+#endif
+}
+
+inline constexpr std::size_t visit_block_size = 64;
+
+#define LTL_VISIT_CASE(i)                                                                                              \
+    case Offset + (i):                                                                                                 \
+        if constexpr (Offset + (i) < size)                                                                             \
+            return ltl::invoke(FWD(f), std::get<Offset + (i)>(FWD(v)));                                                \
+        else                                                                                                           \
+            unreachable();
+#define LTL_VISIT_CASE_4(i) LTL_VISIT_CASE(i) LTL_VISIT_CASE(i + 1) LTL_VISIT_CASE(i + 2) LTL_VISIT_CASE(i + 3)
+#define LTL_VISIT_CASE_16(i)                                                                                           \
+    LTL_VISIT_CASE_4(i) LTL_VISIT_CASE_4(i + 4) LTL_VISIT_CASE_4(i + 8) LTL_VISIT_CASE_4(i + 12)
+
+// The alternatives are dispatched by blocks of 64 cases, that the compiler turns into a jump table, and the calls can
+// be inlined
+template <std::size_t Offset, typename F, typename V>
+constexpr decltype(auto) visit_alternative(F &&f, V &&v, std::size_t index) {
+    constexpr std::size_t size = std::variant_size_v<ltl::remove_cvref_t<V>>;
+    switch (index) {
+        LTL_VISIT_CASE_16(0)
+        LTL_VISIT_CASE_16(16)
+        LTL_VISIT_CASE_16(32)
+        LTL_VISIT_CASE_16(48)
+    default:
+        if constexpr (Offset + visit_block_size < size)
+            return visit_alternative<Offset + visit_block_size>(FWD(f), FWD(v), index);
+        else
+            unreachable();
+    }
+}
+
+#undef LTL_VISIT_CASE_16
+#undef LTL_VISIT_CASE_4
+#undef LTL_VISIT_CASE
+
+template <typename F, typename V>
+constexpr decltype(auto) visit_one(F &&f, V &&v) {
+    if (v.valueless_by_exception())
+        throw std::bad_variant_access{};
+    const std::size_t index = v.index();
+    return visit_alternative<0>(FWD(f), FWD(v), index);
+}
+} // namespace details
+
+/// \endcond
+
+template <typename F, typename V, typename... Vs>
+/**
+ * @brief visit - The same as `std::visit`, with a switch instead of a table of function pointers
+ *
+ * The visitor must return the same type for every alternative. With several variants, they are visited one after the
+ * other, so the number of instantiated functions is the product of the numbers of alternatives, but no table of all the
+ * combinations is built.
+ *
+ * @code
+ *  std::variant<int, std::string> a = 5;
+ *  std::variant<int, double> b = 2.0;
+ *  auto size = ltl::visit([](const auto &x, auto y) { return sizeof(x) + sizeof(y); }, a, b);
+ * @endcode
+ */
+constexpr decltype(auto) visit(F &&f, V &&v, Vs &&... vs) {
+    if constexpr (sizeof...(Vs) == 0) {
+        return details::visit_one(FWD(f), FWD(v));
+    } else {
+        return details::visit_one(
+            [&f, &vs...](auto &&x) -> decltype(auto) {
+                return ltl::visit(
+                    [&f, &x](auto &&... xs) -> decltype(auto) { return ltl::invoke(FWD(f), FWD(x), FWD(xs)...); },
+                    FWD(vs)...);
+            },
+            FWD(v));
+    }
+}
+
 template <typename V, typename... Fs>
 /**
  * @brief match Simple variant visitation
  *
- * It is roughly equivalent to `std::visit(overloader{FWD(fs)...}, FWD(v));`
+ * It is roughly equivalent to `ltl::visit(overloader{FWD(fs)...}, FWD(v));`
  */
 constexpr decltype(auto) match(V &&v, Fs &&... fs) {
-    return ::std::visit(overloader{FWD(fs)...}, FWD(v));
+    return ltl::visit(overloader{FWD(fs)...}, FWD(v));
 }
 
 template <typename Variant, typename... Fs>
@@ -36,7 +127,7 @@ constexpr auto match_result(Variant &&variant, Fs... fs) {
     using result_types = typename fast::apply<qualified_types, result_from_function::template apply>::type;
     using result_type = typename fast::rename<result_types, std::variant>::type;
     auto function = overloader{std::move(fs)...};
-    return std::visit([&function](auto &&x) -> result_type { return function(FWD(x)); }, FWD(variant));
+    return ltl::visit([&function](auto &&x) -> result_type { return function(FWD(x)); }, FWD(variant));
 }
 
 template <typename F, typename Variant>
@@ -79,13 +170,106 @@ class recursive_wrapper {
     std::unique_ptr<T> m_ptr;
 };
 
+namespace details {
+inline thread_local std::pmr::memory_resource *current_arena = nullptr;
+} // namespace details
+
+/// \endcond
+
+/**
+ * @brief arena_scope - Chooses the arena of the arena_recursive_wrapper built by this thread while it is alive
+ *
+ * The scopes can be nested: the previous arena is restored at the end of the scope.
+ */
+class arena_scope {
+  public:
+    explicit arena_scope(std::pmr::memory_resource &arena) noexcept :
+        m_previous{std::exchange(details::current_arena, &arena)} {}
+
+    arena_scope(const arena_scope &) = delete;
+    arena_scope &operator=(const arena_scope &) = delete;
+
+    ~arena_scope() { details::current_arena = m_previous; }
+
+  private:
+    std::pmr::memory_resource *m_previous;
+};
+
+template <typename T>
+/**
+ * @brief arena_recursive_wrapper - A recursive_wrapper whose node is allocated in an arena
+ *
+ * The node is allocated in the arena of the current `arena_scope`, usually a `std::pmr::monotonic_buffer_resource`:
+ * building a tree is a pointer bump per node instead of a call to `malloc`, and the nodes are next to each other in
+ * memory. The destructor only destroys the node: the memory is given back when the arena is released, so the arena must
+ * outlive the tree. Once built, the tree can be used and destroyed outside of the scope.
+ *
+ * @code
+ *  using Expression = ltl::recursive_variant<int, ltl::arena_recursive_wrapper<struct Add>>;
+ *  struct Add {
+ *      Expression lhs, rhs;
+ *  };
+ *
+ *  std::pmr::monotonic_buffer_resource arena;
+ *  ltl::arena_scope scope{arena};
+ *  Expression expression = Add{1, Add{2, 3}};
+ * @endcode
+ */
+class arena_recursive_wrapper {
+  public:
+    static constexpr auto type = type_v<T>;
+
+  public:
+    arena_recursive_wrapper(T &&t) : m_ptr{make(std::move(t))} {}
+
+    arena_recursive_wrapper(const arena_recursive_wrapper &other) = delete;
+    arena_recursive_wrapper(arena_recursive_wrapper &&other) noexcept : m_ptr{std::exchange(other.m_ptr, nullptr)} {}
+
+    arena_recursive_wrapper &operator=(const arena_recursive_wrapper &) = delete;
+    arena_recursive_wrapper &operator=(arena_recursive_wrapper &&other) noexcept {
+        std::swap(m_ptr, other.m_ptr);
+        return *this;
+    }
+
+    arena_recursive_wrapper &operator=(T &&v) {
+        *this = arena_recursive_wrapper{std::move(v)};
+        return *this;
+    }
+
+    ~arena_recursive_wrapper() {
+        if (m_ptr)
+            m_ptr->~T();
+    }
+
+    T &operator*() noexcept { return *m_ptr; }
+    const T &operator*() const noexcept { return *m_ptr; }
+
+    T *operator->() noexcept { return m_ptr; }
+    const T *operator->() const noexcept { return m_ptr; }
+
+  private:
+    static T *make(T &&t) {
+        assert(details::current_arena && "An arena_recursive_wrapper must be built inside an arena_scope");
+        void *memory = details::current_arena->allocate(sizeof(T), alignof(T));
+        return ::new (memory) T(std::move(t));
+    }
+
+    T *m_ptr;
+};
+
+/// \cond
+
 LTL_MAKE_IS_KIND(recursive_wrapper, is_recursive_wrapper, IsRecursiveWrapper, typename, );
+LTL_MAKE_IS_KIND(arena_recursive_wrapper, is_arena_recursive_wrapper, IsArenaRecursiveWrapper, typename, );
 
 /// \endcond
 
 template <typename... Ts>
 /**
  * @brief The recursive_variant class - A variant that supports recursive type
+ *
+ * The recursive alternatives are either `recursive_wrapper`, which allocates each node on the heap, or
+ * `arena_recursive_wrapper`, which allocates them in an arena.
  */
 class recursive_variant {
     /// \cond
@@ -110,21 +294,9 @@ class recursive_variant {
         return *this;
     }
 
+    // A friend defined in the class would be defined again by each recursive_variant
     template <typename F, typename... Variants>
-    friend decltype(auto) recursive_visit(F &&f, Variants &&... variants) {
-        std::visit(
-            [&f](auto &&... xs) {
-                auto unwrap = [](auto &x) -> decltype(auto) {
-                    if constexpr (IsRecursiveWrapper<decltype(x)>) { //
-                        return *x;
-                    } else {
-                        return (x);
-                    }
-                };
-                ltl::invoke(static_cast<F &&>(f), unwrap(FWD(xs))...);
-            },
-            FWD(variants).m_variant...);
-    }
+    friend decltype(auto) recursive_visit(F &&f, Variants &&... variants);
 
     /// \endcond
 
@@ -132,6 +304,26 @@ class recursive_variant {
     std::variant<Ts...> m_variant;
 };
 
+/// \cond
+
+template <typename F, typename... Variants>
+decltype(auto) recursive_visit(F &&f, Variants &&... variants) {
+    ltl::visit(
+        [&f](auto &&... xs) {
+            auto unwrap = [](auto &x) -> decltype(auto) {
+                if constexpr (IsRecursiveWrapper<decltype(x)> || IsArenaRecursiveWrapper<decltype(x)>) { //
+                    return *x;
+                } else {
+                    return (x);
+                }
+            };
+            ltl::invoke(static_cast<F &&>(f), unwrap(FWD(xs))...);
+        },
+        FWD(variants).m_variant...);
+}
+
+/// \endcond
+
 /// @}
 
 } // namespace ltl
@@ -12,7 +12,9 @@
 #include "invoke.h"
 #include "concept.h"
 #include "optional.h"
+#include "simd.h"
 #include "Range/Range.h"
+#include "Range/Segmented.h"
 
 #ifdef __cpp_lib_constexpr_algorithms
 #define LTL_CONSTEXPR_ALGO constexpr
@@ -33,6 +35,78 @@ using std::begin;
 using std::end;
 using std::size;
 
+/// \cond
+namespace details {
+// The segmented iterators (see Segmented.h) are walked one local range at a time, and the local ranges may be
+// segmented too (a join of joins)
+template <typename It, typename F>
+LTL_CONSTEXPR_ALGO void segmented_for_each(It first, It last, F &f) {
+    if constexpr (IsSegmentedIterator<It>) {
+        for_each_segment(std::move(first), std::move(last), [&f](auto localFirst, auto localLast) {
+            segmented_for_each(std::move(localFirst), localLast, f);
+            return localLast;
+        });
+    } else {
+        std::for_each(std::move(first), std::move(last), std::ref(f));
+    }
+}
+
+template <typename It, typename F>
+LTL_CONSTEXPR_ALGO std::size_t segmented_count_if(It first, It last, F &f) {
+    if constexpr (IsSegmentedIterator<It>) {
+        std::size_t result = 0;
+        for_each_segment(std::move(first), std::move(last), [&result, &f](auto localFirst, auto localLast) {
+            result += segmented_count_if(std::move(localFirst), localLast, f);
+            return localLast;
+        });
+        return result;
+    } else {
+        return std::count_if(std::move(first), std::move(last), std::ref(f));
+    }
+}
+
+template <typename It, typename F>
+LTL_CONSTEXPR_ALGO It segmented_find_if(It first, It last, F &f) {
+    if constexpr (IsSegmentedIterator<It>) {
+        return for_each_segment(std::move(first), std::move(last), [&f](auto localFirst, auto localLast) {
+            return segmented_find_if(std::move(localFirst), std::move(localLast), f);
+        });
+    } else {
+        return std::find_if(std::move(first), std::move(last), std::ref(f));
+    }
+}
+
+template <typename It, typename Out>
+LTL_CONSTEXPR_ALGO Out segmented_copy(It first, It last, Out out) {
+    if constexpr (IsSegmentedIterator<It>) {
+        for_each_segment(std::move(first), std::move(last), [&out](auto localFirst, auto localLast) {
+            out = segmented_copy(std::move(localFirst), localLast, std::move(out));
+            return localLast;
+        });
+        return out;
+    } else {
+        return std::copy(std::move(first), std::move(last), std::move(out));
+    }
+}
+
+// init is a parameter of each call, so the compiler knows it does not alias the elements of the local range
+template <typename It, typename T, typename BinaryOperation>
+constexpr T segmented_accumulate(It first, It last, T init, BinaryOperation &op) {
+    if constexpr (IsSegmentedIterator<It>) {
+        for_each_segment(std::move(first), std::move(last), [&init, &op](auto localFirst, auto localLast) {
+            init = segmented_accumulate(std::move(localFirst), localLast, std::move(init), op);
+            return localLast;
+        });
+    } else {
+        for (; first != last; ++first) {
+            init = ltl::invoke(op, std::move(init), *first);
+        }
+    }
+    return init;
+}
+} // namespace details
+/// \endcond
+
 template <typename C, typename F>
 LTL_CONSTEXPR_ALGO auto consecutive_values(C &c, std::size_t n, F f) {
     std::size_t consecutiveValues = 0;
@@ -81,19 +155,35 @@ LTL_CONSTEXPR_ALGO auto none_of(const C &c, F &&f) {
 template <typename C, typename F, requires_f(IsIterable<C>)>
 LTL_CONSTEXPR_ALGO auto for_each(C &&c, F &&f) {
     static_assert(IsIterable<C>, "C must be iterable");
-    return std::for_each(begin(FWD(c)), end(FWD(c)), MAKE_CALLER(f));
+    if constexpr (details::IsSegmentedIterator<decltype(begin(FWD(c)))>) {
+        auto caller = MAKE_CALLER(f);
+        details::segmented_for_each(begin(FWD(c)), end(FWD(c)), caller);
+        return caller;
+    } else {
+        return std::for_each(begin(FWD(c)), end(FWD(c)), MAKE_CALLER(f));
+    }
 }
 
 template <typename C, typename V>
 LTL_CONSTEXPR_ALGO auto count(const C &c, const V &v) {
     static_assert(IsIterable<C>, "C must be iterable");
+    if constexpr (details::IsSimdSearchable<decltype(begin(c)), V>) {
+        if (!details::is_constant_evaluated())
+            return details::simd_count(begin(c), end(c), v);
+    }
     return std::count(begin(c), end(c), v);
 }
 
 template <typename C, typename F>
 LTL_CONSTEXPR_ALGO auto count_if(const C &c, F &&f) {
     static_assert(IsIterable<C>, "C must be iterable");
-    return std::count_if(begin(c), end(c), MAKE_CALLER(f));
+    if constexpr (details::IsSegmentedIterator<decltype(begin(c))>) {
+        auto caller = MAKE_CALLER(f);
+        return static_cast<typename std::iterator_traits<decltype(begin(c))>::difference_type>(
+            details::segmented_count_if(begin(c), end(c), caller));
+    } else {
+        return std::count_if(begin(c), end(c), MAKE_CALLER(f));
+    }
 }
 
 template <typename C1, typename C2>
@@ -121,13 +211,17 @@ LTL_CONSTEXPR_ALGO auto mismatch(C1 &c1, C2 &c2, F &&f) {
 template <typename C, typename V>
 LTL_CONSTEXPR_ALGO auto find(C &c, const V &v) {
     static_assert(IsIterable<C>, "C must be iterable");
+    if constexpr (details::IsSimdSearchable<decltype(begin(c)), V>) {
+        if (!details::is_constant_evaluated())
+            return details::simd_find(begin(c), end(c), v);
+    }
     return std::find(begin(c), end(c), v);
 }
 
 template <typename C, typename V>
 LTL_CONSTEXPR_ALGO auto find_ptr(C &c, const V &v) {
     static_assert(IsIterable<C>, "C must be iterable");
-    auto it = std::find(begin(c), end(c), v);
+    auto it = find(c, v);
     if (it != end(c)) {
         return std::addressof(*it);
     }
@@ -137,7 +231,7 @@ LTL_CONSTEXPR_ALGO auto find_ptr(C &c, const V &v) {
 template <typename C, typename V>
 LTL_CONSTEXPR_ALGO auto find_value(const C &c, const V &v) {
     static_assert(IsIterable<C>, "C must be iterable");
-    auto it = std::find(begin(c), end(c), v);
+    auto it = find(c, v);
     if (it != end(c)) {
         return ltl::make_optional(*it);
     }
@@ -147,7 +241,7 @@ LTL_CONSTEXPR_ALGO auto find_value(const C &c, const V &v) {
 template <typename C, typename V>
 LTL_CONSTEXPR_ALGO auto find_nullable(const C &c, const V &v) {
     static_assert(IsIterable<C>, "C must be iterable");
-    auto it = std::find(begin(c), end(c), v);
+    auto it = find(c, v);
     if (it != end(c)) {
         return *it;
     }
@@ -157,7 +251,12 @@ LTL_CONSTEXPR_ALGO auto find_nullable(const C &c, const V &v) {
 template <typename C, typename F>
 LTL_CONSTEXPR_ALGO auto find_if(C &c, F &&f) {
     static_assert(IsIterable<C>, "C must be iterable");
-    return std::find_if(begin(c), end(c), MAKE_CALLER(f));
+    if constexpr (details::IsSegmentedIterator<decltype(begin(c))>) {
+        auto caller = MAKE_CALLER(f);
+        return details::segmented_find_if(begin(c), end(c), caller);
+    } else {
+        return std::find_if(begin(c), end(c), MAKE_CALLER(f));
+    }
 }
 
 template <typename C, typename F>
@@ -374,7 +473,11 @@ LTL_CONSTEXPR_ALGO auto search_n_value(const C &c, Size count, const V &v, F &&f
 template <typename C, typename It>
 LTL_CONSTEXPR_ALGO auto copy(const C &c, It &&it) {
     static_assert(IsIterable<C>, "C must be iterable");
-    return std::copy(begin(c), end(c), FWD(it));
+    if constexpr (details::IsSegmentedIterator<decltype(begin(c))>) {
+        return details::segmented_copy(begin(c), end(c), ltl::remove_cvref_t<It>{FWD(it)});
+    } else {
+        return std::copy(begin(c), end(c), FWD(it));
+    }
 }
 
 template <typename C, typename It, typename F>
@@ -1122,24 +1225,33 @@ LTL_CONSTEXPR_ALGO auto iota(C &c, V &&v) {
 template <typename C, typename T>
 constexpr T accumulate(const C &c, T init) {
     static_assert(IsIterable<C>, "C must be iterable");
-    auto b = begin(c);
-    auto e = end(c);
-    for (; b != e; ++b) {
-        init = std::move(init) + *b;
-    }
+    if constexpr (details::IsSegmentedIterator<decltype(begin(c))>) {
+        std::plus<> op;
+        return details::segmented_accumulate(begin(c), end(c), std::move(init), op);
+    } else {
+        auto b = begin(c);
+        auto e = end(c);
+        for (; b != e; ++b) {
+            init = std::move(init) + *b;
+        }
 
-    return init;
+        return init;
+    }
 }
 
 template <typename C, typename T, typename BinaryOperation>
 constexpr T accumulate(const C &c, T init, BinaryOperation &&op) {
     static_assert(IsIterable<C>, "C must be iterable");
-    auto b = begin(c);
-    auto e = end(c);
-    for (; b != e; ++b) {
-        init = ltl::invoke(FWD(op), std::move(init), *b);
+    if constexpr (details::IsSegmentedIterator<decltype(begin(c))>) {
+        return details::segmented_accumulate(begin(c), end(c), std::move(init), op);
+    } else {
+        auto b = begin(c);
+        auto e = end(c);
+        for (; b != e; ++b) {
+            init = ltl::invoke(FWD(op), std::move(init), *b);
+        }
+        return init;
     }
-    return init;
 }
 
 template <typename C, typename It, typename T>
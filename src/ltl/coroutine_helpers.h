@@ -12,18 +12,140 @@
 #endif
 
 #if LTL_COROUTINE
+#include <array>
 #include <coroutine>
+#include <cstddef>
+#include <new>
 
 namespace ltl {
+
+/// \cond
+
+namespace details {
+
+/**
+ * A thread local cache of coroutine frames. The frames are rounded up to a multiple of 64 bytes, and up to 16 frames
+ * of each size are kept once released: a coroutine created right after another one of the same size reuses its
+ * memory instead of calling operator new.
+ */
+class coroutine_frame_cache {
+    static constexpr std::size_t granularity = 64;
+    static constexpr std::size_t max_frame_size = 1024;
+    static constexpr std::size_t max_cached_frames = 16;
+
+    struct free_frame {
+        free_frame *next;
+    };
+
+    struct free_list {
+        free_frame *head = nullptr;
+        std::size_t size = 0;
+    };
+
+  public:
+    static void *allocate(std::size_t size) {
+        if (size > max_frame_size || destroyed)
+            return ::operator new(size);
+        free_list &list = instance().m_lists[index(size)];
+        if (!list.head)
+            return ::operator new(rounded(size));
+        --list.size;
+        return std::exchange(list.head, list.head->next);
+    }
+
+    static void deallocate(void *frame, std::size_t size) noexcept {
+        if (size > max_frame_size || destroyed) {
+            ::operator delete(frame);
+            return;
+        }
+        free_list &list = instance().m_lists[index(size)];
+        if (list.size == max_cached_frames) {
+            ::operator delete(frame);
+            return;
+        }
+        ++list.size;
+        list.head = ::new (frame) free_frame{list.head};
+    }
+
+    ~coroutine_frame_cache() {
+        // The frames released after the destruction of the cache are directly deleted
+        destroyed = true;
+        for (free_list &list : m_lists) {
+            while (list.head)
+                ::operator delete(std::exchange(list.head, list.head->next));
+        }
+    }
+
+  private:
+    static std::size_t index(std::size_t size) noexcept { return (size + granularity - 1) / granularity - 1; }
+    static std::size_t rounded(std::size_t size) noexcept { return (index(size) + 1) * granularity; }
+
+    static coroutine_frame_cache &instance() noexcept {
+        thread_local coroutine_frame_cache cache;
+        return cache;
+    }
+
+    static inline thread_local bool destroyed = false;
+
+    std::array<free_list, max_frame_size / granularity> m_lists{};
+};
+
+} // namespace details
+
+/// \endcond
+
+/**
+ * @brief recycled_frame - The coroutine frames of a promise type deriving from it are recycled
+ *
+ * The frames are taken from a thread local cache instead of the heap, which is what makes short lived coroutines
+ * cheap: see `ltl::generator`.
+ */
+struct recycled_frame {
+    static void *operator new(std::size_t size) { return details::coroutine_frame_cache::allocate(size); }
+
+    static void operator delete(void *frame, std::size_t size) noexcept {
+        details::coroutine_frame_cache::deallocate(frame, size);
+    }
+};
+
 template <typename T>
-struct promise_type {
-    T *resultObject;
-    T get_return_object() noexcept { return {*this}; }
+struct promise_type : recycled_frame {
+    /**
+     * The result is written in the object returned by get_return_object, which lives in the caller and is converted to
+     * T once the coroutine has ended: T may be trivially copyable and returned in registers.
+     */
+    class return_object {
+      public:
+        return_object(promise_type &promise) noexcept { promise.m_result = &m_result; }
+        return_object(const return_object &) = delete;
+        return_object &operator=(const return_object &) = delete;
+
+        operator T() && noexcept { return std::move(*m_result); }
+
+      private:
+        std::optional<T> m_result;
+    };
+
+    return_object get_return_object() noexcept { return {*this}; }
     std::suspend_never initial_suspend() noexcept { return {}; }
     std::suspend_never final_suspend() noexcept { return {}; }
 
-    void return_value(T result) noexcept { *resultObject = std::move(result); }
+    template <typename... Args>
+    void emplace_result(Args &&...args) noexcept {
+        m_result->emplace(FWD(args)...);
+    }
+
+    void return_value(T result) noexcept { emplace_result(std::move(result)); }
+
+    template <typename U>
+    void return_value(U &&result) noexcept {
+        emplace_result(FWD(result));
+    }
+
     void unhandled_exception() noexcept {}
+
+  private:
+    std::optional<T> *m_result;
 };
 } // namespace ltl
 #endif
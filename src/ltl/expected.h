@@ -23,6 +23,203 @@ struct error_tag_t {};
 inline constexpr value_tag_t value_tag{};
 inline constexpr error_tag_t error_tag{};
 
+/**
+ * @brief niche - A value that a type never takes, specialize it to make an `ltl::expected` smaller
+ *
+ * When the other alternative of an expected is an empty type, like `ltl::Ok`, the expected holds the niche value
+ * instead of a separate tag: `expected<Ok, ErrorCode>` is as large as `ErrorCode`. A null pointer is never an error, so
+ * it is the niche of the pointer errors without any specialization: `expected<Ok, const char *>` is a single pointer.
+ * A null pointer is a valid result however, so `expected<Node *, Ok>` keeps its flag unless `niche<Node *>` is
+ * specialized.
+ *
+ * @code
+ *  enum class ParseError : std::uint8_t { none, invalid_character, too_long };
+ *
+ *  template <>
+ *  struct ltl::niche<ParseError> {
+ *      static constexpr ParseError value = ParseError::none;
+ *  };
+ *
+ *  static_assert(sizeof(ltl::expected<ltl::Ok, ParseError>) == 1);
+ * @endcode
+ */
+template <typename T, typename = void>
+struct niche;
+
+template <typename Result, typename Err>
+class expected;
+
+/// \cond
+
+LTL_MAKE_IS_KIND(expected, is_expected, IsExpected, typename, ...);
+
+namespace details {
+
+template <typename T, typename = void>
+struct has_niche : false_t {};
+
+template <typename T>
+struct has_niche<T, std::void_t<decltype(niche<T>::value)>> : true_t {};
+
+// Null is the niche of a pointer only when it is the error
+template <typename T, std::size_t ValueIndex>
+constexpr bool HasExpectedNiche = has_niche<T>::value || (std::is_pointer_v<T> && ValueIndex == 1);
+
+template <typename T>
+constexpr T niche_value() noexcept {
+    if constexpr (has_niche<T>::value)
+        return niche<T>::value;
+    else
+        return nullptr;
+}
+
+template <typename T>
+constexpr bool IsNicheAlternative = std::is_empty_v<T> && !std::is_final_v<T> && std::is_trivially_copyable_v<T> &&
+                                    std::is_default_constructible_v<T>;
+
+template <typename Value, typename Empty, std::size_t ValueIndex>
+constexpr bool IsNicheLayout =
+    HasExpectedNiche<Value, ValueIndex> && IsNicheAlternative<Empty> && std::is_trivially_copyable_v<Value>;
+
+// The expected is trivially copyable, so it is returned in registers when it is small enough
+template <typename Result, typename Err>
+constexpr bool IsUnionLayout = std::is_trivially_copyable_v<Result> && std::is_trivially_copyable_v<Err>;
+
+// The alternative built by the converting constructor of an expected, chosen by overload resolution like std::variant
+template <typename Result, typename Err>
+struct expected_alternative_selector {
+    static std::integral_constant<std::size_t, 0> select(Result);
+    static std::integral_constant<std::size_t, 1> select(Err);
+};
+
+template <typename T, typename Result, typename Err>
+constexpr std::size_t expected_alternative =
+    decltype(expected_alternative_selector<Result, Err>::select(std::declval<T>()))::value;
+
+// Index 0 is the result, index 1 the error
+
+template <typename Result, typename Err>
+class expected_variant_storage {
+  public:
+    template <std::size_t I, typename... Args>
+    constexpr expected_variant_storage(std::in_place_index_t<I> index, Args &&...args) :
+        m_variant{index, FWD(args)...} {}
+
+    constexpr std::size_t index() const noexcept { return m_variant.index(); }
+
+    template <std::size_t I>
+    constexpr auto &get() & noexcept {
+        return *std::get_if<I>(&m_variant);
+    }
+
+    template <std::size_t I>
+    constexpr const auto &get() const &noexcept {
+        return *std::get_if<I>(&m_variant);
+    }
+
+    constexpr friend bool operator==(const expected_variant_storage &a, const expected_variant_storage &b) noexcept {
+        return a.m_variant == b.m_variant;
+    }
+
+  private:
+    std::variant<Result, Err> m_variant;
+};
+
+template <typename Result, typename Err>
+class expected_union_storage {
+  public:
+    template <typename... Args>
+    constexpr expected_union_storage(std::in_place_index_t<0>, Args &&...args) :
+        m_result(FWD(args)...), m_isError{false} {}
+
+    template <typename... Args>
+    constexpr expected_union_storage(std::in_place_index_t<1>, Args &&...args) :
+        m_error(FWD(args)...), m_isError{true} {}
+
+    constexpr std::size_t index() const noexcept { return m_isError; }
+
+    template <std::size_t I>
+    constexpr auto &get() & noexcept {
+        if constexpr (I == 0)
+            return m_result;
+        else
+            return m_error;
+    }
+
+    template <std::size_t I>
+    constexpr const auto &get() const &noexcept {
+        if constexpr (I == 0)
+            return m_result;
+        else
+            return m_error;
+    }
+
+    constexpr friend bool operator==(const expected_union_storage &a, const expected_union_storage &b) noexcept {
+        if (a.m_isError != b.m_isError)
+            return false;
+        return a.m_isError ? a.m_error == b.m_error : a.m_result == b.m_result;
+    }
+
+  private:
+    union {
+        Result m_result;
+        Err m_error;
+    };
+    bool m_isError;
+};
+
+// The empty alternative is a base class, so it takes no space, and the niche value of the other one means it is held
+template <typename Value, typename Empty, std::size_t ValueIndex>
+class expected_niche_storage : private Empty {
+  public:
+    template <typename... Args>
+    constexpr expected_niche_storage(std::in_place_index_t<ValueIndex>, Args &&...args) : m_value(FWD(args)...) {
+        assert(!(m_value == niche_value<Value>()) && "The niche value cannot be held by an expected");
+    }
+
+    template <typename... Args>
+    constexpr expected_niche_storage(std::in_place_index_t<1 - ValueIndex>, Args &&...) :
+        m_value(niche_value<Value>()) {}
+
+    constexpr std::size_t index() const noexcept {
+        return m_value == niche_value<Value>() ? 1 - ValueIndex : ValueIndex;
+    }
+
+    template <std::size_t I>
+    constexpr auto &get() & noexcept {
+        if constexpr (I == ValueIndex)
+            return m_value;
+        else
+            return static_cast<Empty &>(*this);
+    }
+
+    template <std::size_t I>
+    constexpr const auto &get() const &noexcept {
+        if constexpr (I == ValueIndex)
+            return m_value;
+        else
+            return static_cast<const Empty &>(*this);
+    }
+
+    constexpr friend bool operator==(const expected_niche_storage &a, const expected_niche_storage &b) noexcept {
+        return a.m_value == b.m_value;
+    }
+
+  private:
+    Value m_value;
+};
+
+template <typename Result, typename Err>
+using expected_storage = std::conditional_t<
+    IsNicheLayout<Result, Err, 0>, expected_niche_storage<Result, Err, 0>,
+    std::conditional_t<IsNicheLayout<Err, Result, 1>, expected_niche_storage<Err, Result, 1>,
+                       std::conditional_t<IsUnionLayout<Result, Err>, expected_union_storage<Result, Err>,
+                                          expected_variant_storage<Result, Err>>>>;
+
+} // namespace details
+
+/// \endcond
+
 template <typename Result, typename Err>
 /**
  * @brief The expected class
@@ -61,7 +258,8 @@ template <typename Result, typename Err>
  *  auto complicateResult = readFile("path.txt").and_then(complicateProcess);
  * @endcode
  *
- * The last way can be used when coroutines are available.
+ * The last way can be used when coroutines are available. An error ends the coroutine and is returned without any
+ * exception, and the coroutine frames are recycled instead of being allocated on each call.
  *
  * @code
  *  expected<std::vector<u8>, Error> readFile(std::string_view path);
@@ -71,6 +269,10 @@ template <typename Result, typename Err>
  *  auto simpleResult = simpleProcess(result);
  *  auto complicateResult = co_await complicateProcess(result);
  * @endcode
+ *
+ * When one alternative is empty and the other one has a `ltl::niche`, the niche value means the empty alternative, so
+ * it cannot be held as a value: `expected<Ok, const char *>{nullptr}` is an error built from a null pointer, which
+ * asserts. Null pointers are only a niche of the errors, so `expected<Node *, Ok>{nullptr}` is a valid result.
  */
 class [[nodiscard]] expected : public ltl::crtp::Comparable<expected<Result, Err>> {
     /// \cond
@@ -78,13 +280,16 @@ class [[nodiscard]] expected : public ltl::crtp::Comparable<expected<Result, Err
     using value_type = Result;
     using error_type = Err;
 
-    constexpr friend bool operator==(const expected &a, const expected &b) noexcept { return a.m_result == b.m_result; }
+    constexpr friend bool operator==(const expected &a, const expected &b) noexcept {
+        return a.m_storage == b.m_storage;
+    }
 
     static_assert(!std::is_reference_v<value_type>, "value_type must not be a reference");
     static_assert(!std::is_reference_v<error_type>, "error_type must not be a reference");
 
-    template <typename T>
-    constexpr expected(T && t) : m_result{FWD(t)} {}
+    template <typename T, requires_f(!IsExpected<T>)>
+    constexpr expected(T && t) :
+        m_storage{std::in_place_index<details::expected_alternative<T, Result, Err>>, FWD(t)} {}
 
     constexpr expected(expected &&) = default;
     constexpr expected(const expected &) = default;
@@ -92,71 +297,64 @@ class [[nodiscard]] expected : public ltl::crtp::Comparable<expected<Result, Err
     constexpr expected &operator=(const expected &) = default;
 
     template <typename T>
-    constexpr expected(value_tag_t, T && t) : m_result{std::in_place_index<1>, FWD(t)} {}
+    constexpr expected(value_tag_t, T && t) : m_storage{std::in_place_index<0>, FWD(t)} {}
 
     template <typename T>
-    constexpr expected(error_tag_t, T && t) : m_result{std::in_place_index<2>, FWD(t)} {}
+    constexpr expected(error_tag_t, T && t) : m_storage{std::in_place_index<1>, FWD(t)} {}
 
     template <typename T, typename E>
-    constexpr expected(expected<T, E> t) {
-        if (t)
-            m_result = value_type(std::move(t).result());
-        else
-            m_result = error_type(std::move(t).error());
-    }
+    constexpr expected(expected<T, E> t) :
+        m_storage{t ? storage_type{std::in_place_index<0>, value_type(std::move(t).result())}
+                    : storage_type{std::in_place_index<1>, error_type(std::move(t).error())}} {}
 
     template <typename R, typename E>
     constexpr expected &operator=(expected<R, E> t) {
-        if (t)
-            m_result = value_type(std::move(t).result());
-        else
-            m_result = error_type(std::move(t).error());
-        return *this;
+        return *this = expected{std::move(t)};
     }
 
     template <typename T>
     constexpr expected &operator=(T) = delete;
 
-    constexpr operator bool() const noexcept { return m_result.index() == 1; }
+    constexpr operator bool() const noexcept { return m_storage.index() == 0; }
 
     constexpr value_type &result() & noexcept {
-        assert(m_result.index() == 1);
-        return std::get<1>(m_result);
+        assert(is_result());
+        return m_storage.template get<0>();
     }
 
     constexpr const value_type &result() const &noexcept {
-        assert(m_result.index() == 1);
-        return std::get<1>(m_result);
+        assert(is_result());
+        return m_storage.template get<0>();
     }
 
     constexpr value_type result() && noexcept {
-        assert(m_result.index() == 1);
-        return std::get<1>(std::move(m_result));
+        assert(is_result());
+        return std::move(m_storage.template get<0>());
     }
 
     constexpr const value_type result() const &&noexcept {
-        assert(m_result.index() == 1);
-        return std::get<1>(std::move(m_result));
+        assert(is_result());
+        return std::move(m_storage.template get<0>());
     }
 
     constexpr error_type error() && noexcept {
-        assert(m_result.index() == 2);
-        return std::get<2>(std::move(m_result));
+        assert(is_error());
+        return std::move(m_storage.template get<1>());
     }
 
     constexpr error_type error() const &&noexcept {
-        assert(m_result.index() == 2);
-        return std::get<2>(std::move(m_result));
+        assert(is_error());
+        return std::move(m_storage.template get<1>());
     }
 
     constexpr const error_type &error() const &noexcept {
-        assert(m_result.index() == 2);
-        return std::get<2>(m_result);
+        assert(is_error());
+        return m_storage.template get<1>();
     }
 
     constexpr error_type &error() & noexcept {
-        assert(m_result.index() == 2);
-        return std::get<2>(m_result);
+        assert(is_error());
+        return m_storage.template get<1>();
     }
 
     template <typename... Fs>
@@ -237,42 +435,37 @@ class [[nodiscard]] expected : public ltl::crtp::Comparable<expected<Result, Err
         return std::move(*this).error();
     }
 
-    constexpr bool is_error() const noexcept { return m_result.index() == 2; }
-    constexpr bool is_result() const noexcept { return m_result.index() == 1; }
+    constexpr bool is_error() const noexcept { return m_storage.index() == 1; }
+    constexpr bool is_result() const noexcept { return m_storage.index() == 0; }
 
 #if LTL_COROUTINE
     using promise_type = ltl::promise_type<expected<Result, Err>>;
 
+    // The awaited object lives until the end of the co_await expression: it is not copied
+    template <typename Self>
     struct Awaiter {
-        expected result{};
-        bool await_ready() noexcept { return result.is_result(); }
+        Self &&self;
+        bool await_ready() noexcept { return self.is_result(); }
         template <typename P>
         void await_suspend(std::coroutine_handle<P> handle) {
-            *handle.promise().resultObject =
-                std::remove_pointer_t<decltype(P::resultObject)>{error_tag, std::move(result).error()};
+            handle.promise().emplace_result(error_tag, static_cast<Self &&>(self).error());
             handle.destroy();
         }
-        Result await_resume() noexcept { return std::move(result).result(); }
+        Result await_resume() noexcept { return static_cast<Self &&>(self).result(); }
     };
 
-    Awaiter operator co_await() const & { return {*this}; }
-    Awaiter operator co_await() && { return {std::move(*this)}; }
-
-    expected(promise_type & promise) { promise.resultObject = this; }
-
-    // Because we must not have a trivially copyable object, else it is allowed to passed by registers
-    constexpr ~expected() {}
+    Awaiter<const expected &> operator co_await() const & { return {*this}; }
+    Awaiter<expected> operator co_await() && { return {std::move(*this)}; }
 #endif
 
   private:
-    std::variant<std::monostate, value_type, error_type> m_result;
+    using storage_type = details::expected_storage<Result, Err>;
+    storage_type m_storage;
 
     /// \endcond
 };
 
 /// \cond
-LTL_MAKE_IS_KIND(expected, is_expected, IsExpected, typename, ...);
-
 template <typename T1, typename F, requires_f(IsExpected<T1>)>
 constexpr decltype(auto) operator|(T1 &&a, MapType<F> b) {
     using value_type = decltype(ltl::fast_invoke(std::move(b.f), FWD(a).result()));
@@ -0,0 +1,174 @@
+/**
+ * @file mmap.h
+ */
+#pragma once
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "expected.h"
+#include "Range/Range.h"
+
+namespace ltl {
+
+/**
+ *\defgroup Utils Utilitary group
+ *@{
+ */
+
+/**
+ * @brief The mmap_advice enum - How the pages of a mapped file will be accessed (madvise)
+ *
+ *  - sequential: the kernel reads ahead aggressively and may drop the pages already read
+ *  - random: no read ahead
+ *  - will_need: the pages are read in the background right now
+ */
+enum class mmap_advice { normal, sequential, random, will_need };
+
+/**
+ * @brief The mmap_range class - A read only file mapped in memory, seen as a contiguous range of T
+ *
+ * T must be trivially copyable: the elements are the bytes of the file, without any parsing. Trailing bytes that do
+ * not fill a whole T are not part of the range. The iterators are `const T *`, so the range composes with every view.
+ *
+ * The range owns the mapping: it is movable but not copyable, and the iterators are invalidated when it is destroyed.
+ *
+ * @code
+ *  struct Record {
+ *      std::uint64_t id;
+ *      double value;
+ *  };
+ *
+ *  auto records = ltl::make_mmap_range<Record>("records.bin", ltl::mmap_advice::sequential);
+ *  if (records) {
+ *      auto total = records.result() | ltl::map(&Record::value) | ltl::actions::sum;
+ *      for (auto chunk : records.result() | ltl::chunks(4096))
+ *          process(chunk);
+ *  }
+ *
+ *  auto log = ltl::make_mmap_range("log.txt");
+ *  for (std::string_view line : log.result() | ltl::split_view('\n'))
+ *      parse(line);
+ * @endcode
+ */
+template <typename T = char>
+class mmap_range : public AbstractRange<mmap_range<T>> {
+    static_assert(std::is_trivially_copyable_v<T>, "The elements of a mapped file must be trivially copyable");
+
+  public:
+    mmap_range() noexcept = default;
+
+    mmap_range(mmap_range &&other) noexcept :
+        m_address{std::exchange(other.m_address, nullptr)}, m_length{std::exchange(other.m_length, 0)} {}
+
+    mmap_range &operator=(mmap_range other) noexcept {
+        std::swap(m_address, other.m_address);
+        std::swap(m_length, other.m_length);
+        return *this;
+    }
+
+    ~mmap_range() {
+        if (m_address)
+            ::munmap(m_address, m_length);
+    }
+
+    static expected<mmap_range, std::error_code> open(const std::string &path,
+                                                      mmap_advice advice = mmap_advice::normal) noexcept {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return last_error();
+
+        struct stat status;
+        if (::fstat(fd, &status) != 0) {
+            auto error = last_error();
+            ::close(fd);
+            return error;
+        }
+
+        mmap_range range;
+        // An empty file cannot be mapped: it gives an empty range
+        if (status.st_size > 0) {
+            void *address = ::mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address == MAP_FAILED) {
+                auto error = last_error();
+                ::close(fd);
+                return error;
+            }
+            range.m_address = address;
+            range.m_length = status.st_size;
+        }
+        // The mapping stays valid once the file is closed
+        ::close(fd);
+
+        if (auto error = range.advise(advice))
+            return error;
+        return range;
+    }
+
+    /**
+     * @brief advise - Tells the kernel how the pages will be accessed from now on
+     */
+    std::error_code advise(mmap_advice advice) const noexcept {
+        if (!m_address)
+            return {};
+        if (::madvise(m_address, m_length, to_madvise(advice)) != 0)
+            return last_error();
+        return {};
+    }
+
+    const T *data() const noexcept { return static_cast<const T *>(m_address); }
+    const T *begin() const noexcept { return data(); }
+    const T *end() const noexcept { return data() + size(); }
+    std::size_t size() const noexcept { return m_length / sizeof(T); }
+
+  private:
+    static std::error_code last_error() noexcept { return std::error_code{errno, std::generic_category()}; }
+
+    static int to_madvise(mmap_advice advice) noexcept {
+        switch (advice) {
+        case mmap_advice::sequential:
+            return MADV_SEQUENTIAL;
+        case mmap_advice::random:
+            return MADV_RANDOM;
+        case mmap_advice::will_need:
+            return MADV_WILLNEED;
+        default:
+            return MADV_NORMAL;
+        }
+    }
+
+    void *m_address = nullptr;
+    std::size_t m_length = 0;
+};
+
+template <typename T = char>
+/**
+ * @brief make_mmap_range - Maps a file in memory, or returns the error given by the system
+ *
+ * @code
+ *  auto bytes = ltl::make_mmap_range<std::uint8_t>("image.raw");
+ *  auto records = ltl::make_mmap_range<Record>("records.bin", ltl::mmap_advice::sequential);
+ * @endcode
+ * @param path
+ * @param advice
+ */
+auto make_mmap_range(const std::string &path, mmap_advice advice = mmap_advice::normal) noexcept {
+    return mmap_range<T>::open(path, advice);
+}
+
+/// @}
+
+} // namespace ltl
+
+#endif
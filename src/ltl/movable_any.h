@@ -4,8 +4,12 @@
 #pragma once
 
 #include <cassert>
+#include <cstddef>
 #include <memory>
+#include <new>
+#include <type_traits>
 #include <typeindex>
+#include <typeinfo>
 #include <utility>
 
 namespace ltl {
@@ -54,3 +58,194 @@ class movable_any {
 };
 
 } // namespace ltl
+
+namespace ltl {
+
+/// \cond
+namespace details {
+template <typename Allocator>
+struct unique_any_vtable {
+    const std::type_info &(*type)() noexcept;
+    void *(*ptr)(void *storage) noexcept;
+    // Move constructs the value held by from into to, and destroys the one held by from
+    void (*relocate)(void *from, void *to) noexcept;
+    void (*destroy)(void *storage, Allocator &allocator) noexcept;
+};
+
+template <typename T, typename Allocator, bool Inline>
+struct unique_any_handler;
+
+template <typename T, typename Allocator>
+struct unique_any_handler<T, Allocator, true> {
+    static const std::type_info &type() noexcept { return typeid(T); }
+    static void *ptr(void *storage) noexcept { return storage; }
+
+    static void relocate(void *from, void *to) noexcept {
+        T &value = *static_cast<T *>(from);
+        ::new (to) T(std::move(value));
+        value.~T();
+    }
+
+    static void destroy(void *storage, Allocator &) noexcept { static_cast<T *>(storage)->~T(); }
+
+    static constexpr unique_any_vtable<Allocator> vtable{&type, &ptr, &relocate, &destroy};
+};
+
+// The buffer only holds a pointer to the value, allocated by the allocator
+template <typename T, typename Allocator>
+struct unique_any_handler<T, Allocator, false> {
+    using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+    using traits = std::allocator_traits<allocator_type>;
+
+    static const std::type_info &type() noexcept { return typeid(T); }
+    static void *ptr(void *storage) noexcept { return *static_cast<T **>(storage); }
+
+    static void relocate(void *from, void *to) noexcept { ::new (to) T *(*static_cast<T **>(from)); }
+
+    static void destroy(void *storage, Allocator &allocator) noexcept {
+        allocator_type typedAllocator{allocator};
+        T *value = *static_cast<T **>(storage);
+        traits::destroy(typedAllocator, value);
+        traits::deallocate(typedAllocator, value, 1);
+    }
+
+    static constexpr unique_any_vtable<Allocator> vtable{&type, &ptr, &relocate, &destroy};
+};
+} // namespace details
+/// \endcond
+
+/**
+ * @brief unique_any - A move only movable_any that keeps the small values inline
+ *
+ * A value that fits in `Capacity` bytes, is not more aligned than a double, and whose move constructor does not throw,
+ * is stored inside the object, so constructing, moving and destroying it never allocates. The other values are
+ * allocated with `Allocator`, which can be a pool: it is rebound to the type of the value. The type is dispatched
+ * through a table of function pointers, one per stored type, and there is no reference count: the value is owned by a
+ * single `unique_any`.
+ *
+ * A moved from `unique_any` is empty.
+ *
+ * @code
+ *  std::deque<ltl::unique_any<>> messages;
+ *  messages.emplace_back(42);                      // inline
+ *  messages.emplace_back(std::string{"hello"});    // inline
+ *  messages.emplace_back(std::array<char, 256>{}); // allocated
+ *
+ *  auto message = std::move(messages.front());
+ *  if (message.type() == typeid(int))
+ *      process(message.get<int>());
+ *
+ *  using pooled_any = ltl::unique_any<64, PoolAllocator<std::byte>>;
+ * @endcode
+ */
+template <std::size_t Capacity = 32, typename Allocator = std::allocator<std::byte>>
+class unique_any : private Allocator {
+    static_assert(Capacity >= sizeof(void *), "The inline buffer must be able to hold a pointer");
+
+    using vtable_type = details::unique_any_vtable<Allocator>;
+
+    static constexpr std::size_t alignment = alignof(double);
+
+    template <typename T>
+    static constexpr bool is_inline = sizeof(T) <= Capacity && alignof(T) <= alignment &&
+                                      std::is_nothrow_move_constructible_v<T>;
+
+    template <typename T>
+    static constexpr const vtable_type *vtable_for = &details::unique_any_handler<T, Allocator, is_inline<T>>::vtable;
+
+  public:
+    static constexpr std::size_t capacity = Capacity;
+
+    unique_any() noexcept = default;
+
+    explicit unique_any(const Allocator &allocator) noexcept : Allocator{allocator} {}
+
+    template <typename T, typename = std::enable_if_t<!std::is_same_v<std::decay_t<T>, unique_any>>>
+    unique_any(T &&t, const Allocator &allocator = Allocator{}) : Allocator{allocator} {
+        emplace<std::decay_t<T>>(std::forward<T>(t));
+    }
+
+    unique_any(unique_any &&other) noexcept : Allocator{std::move(other.allocator())} { steal(other); }
+
+    unique_any &operator=(unique_any &&other) noexcept {
+        if (this != &other) {
+            reset();
+            allocator() = std::move(other.allocator());
+            steal(other);
+        }
+        return *this;
+    }
+
+    ~unique_any() { reset(); }
+
+    /**
+     * @brief emplace - Destroys the held value and constructs a T from args
+     */
+    template <typename T, typename... Args>
+    T &emplace(Args &&... args) {
+        static_assert(!std::is_reference_v<T> && !std::is_const_v<T>, "unique_any holds values");
+        reset();
+        if constexpr (is_inline<T>) {
+            ::new (static_cast<void *>(m_storage)) T(std::forward<Args>(args)...);
+        } else {
+            using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+            using traits = std::allocator_traits<allocator_type>;
+            allocator_type typedAllocator{allocator()};
+            T *value = traits::allocate(typedAllocator, 1);
+            try {
+                traits::construct(typedAllocator, value, std::forward<Args>(args)...);
+            } catch (...) {
+                traits::deallocate(typedAllocator, value, 1);
+                throw;
+            }
+            ::new (static_cast<void *>(m_storage)) T *(value);
+        }
+        m_vtable = vtable_for<T>;
+        return *static_cast<T *>(m_vtable->ptr(m_storage));
+    }
+
+    void reset() noexcept {
+        if (m_vtable) {
+            m_vtable->destroy(m_storage, allocator());
+            m_vtable = nullptr;
+        }
+    }
+
+    bool has_value() const noexcept { return m_vtable != nullptr; }
+
+    template <typename T>
+    T &get() noexcept {
+        assert(m_vtable && m_vtable->type() == typeid(T));
+        return *static_cast<T *>(m_vtable->ptr(m_storage));
+    }
+
+    template <typename T>
+    const T &get() const noexcept {
+        return const_cast<unique_any &>(*this).template get<T>();
+    }
+
+    std::type_index type() const noexcept { return m_vtable ? m_vtable->type() : typeid(void); }
+
+    /**
+     * @brief stores_inline - Tells if a T is stored inside the object instead of being allocated
+     */
+    template <typename T>
+    static constexpr bool stores_inline() noexcept {
+        return is_inline<T>;
+    }
+
+  private:
+    Allocator &allocator() noexcept { return *this; }
+
+    void steal(unique_any &other) noexcept {
+        if (other.m_vtable) {
+            other.m_vtable->relocate(other.m_storage, m_storage);
+            m_vtable = std::exchange(other.m_vtable, nullptr);
+        }
+    }
+
+    alignas(alignment) std::byte m_storage[Capacity];
+    const vtable_type *m_vtable = nullptr;
+};
+
+} // namespace ltl
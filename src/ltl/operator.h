@@ -36,7 +36,7 @@ using std::end;
 template <typename T1, requires_f(IsIterable<T1>)>
 constexpr decltype(auto) operator|(T1 &&a, to_vector_t) {
     using value = typename std::iterator_traits<decltype(begin(FWD(a)))>::value_type;
-    return std::vector<value>(begin(FWD(a)), end(FWD(a)));
+    return materialize<std::vector<value>>(begin(FWD(a)), end(FWD(a)));
 }
 
 template <typename T1, requires_f(IsIterable<T1>)>
@@ -51,4 +51,46 @@ constexpr decltype(auto) operator|(T1 &&a, to_list_t) {
     return std::list<value>(begin(FWD(a)), end(FWD(a)));
 }
 
+/// \cond
+template <template <typename...> typename Container>
+struct to_template_t {};
+
+template <typename Container>
+struct to_container_t {};
+/// \endcond
+
+template <template <typename...> typename Container>
+/**
+ * @brief to - Builds a container from a range
+ *
+ * The container can be given as a template, the type of its elements is then the value type of the range, or as a
+ * complete type. The container is reserved when the size of the range, or an upper bound, is known (see
+ * `ltl::materialize`).
+ *
+ * @code
+ *  std::vector<int> values;
+ *  auto strings = values | ltl::filter(is_odd) | ltl::map(lift(std::to_string)) | ltl::to<std::vector>();
+ *  auto doubles = values | ltl::map(half) | ltl::to<std::vector<double>>();
+ * @endcode
+ */
+constexpr to_template_t<Container> to() noexcept {
+    return {};
+}
+
+template <typename Container>
+constexpr to_container_t<Container> to() noexcept {
+    return {};
+}
+
+template <typename T1, template <typename...> typename Container, requires_f(IsIterable<T1>)>
+constexpr decltype(auto) operator|(T1 &&a, to_template_t<Container>) {
+    using value = typename std::iterator_traits<decltype(begin(FWD(a)))>::value_type;
+    return materialize<Container<value>>(begin(FWD(a)), end(FWD(a)));
+}
+
+template <typename T1, typename Container, requires_f(IsIterable<T1>)>
+constexpr decltype(auto) operator|(T1 &&a, to_container_t<Container>) {
+    return materialize<Container>(begin(FWD(a)), end(FWD(a)));
+}
+
 } // namespace ltl
@@ -42,7 +42,8 @@ template <typename T>
  *  x.value_or({});
  * @endcode
  *
- * If coroutines are enabled, it also provides the co_await monadic operator
+ * If coroutines are enabled, it also provides the co_await monadic operator. An empty optional ends the coroutine
+ * without any exception, and the coroutine frames are recycled instead of being allocated on each call.
  *
  * @code
  *  ltl::optional<int> f();
@@ -96,20 +97,21 @@ class optional : private std::optional<T>, public ltl::crtp::Comparable<optional
 #if LTL_COROUTINE
     using promise_type = ltl::promise_type<optional<T>>;
 
+    // The awaited object lives until the end of the co_await expression: it is not copied
+    template <typename Self>
     struct Awaiter {
-        optional result;
-        bool await_ready() noexcept { return result.has_value(); }
-        void await_suspend(std::coroutine_handle<> handle) { handle.destroy(); }
-        T await_resume() noexcept { return *std::move(result); }
+        Self &&self;
+        bool await_ready() noexcept { return self.has_value(); }
+        template <typename P>
+        void await_suspend(std::coroutine_handle<P> handle) {
+            handle.promise().emplace_result(std::nullopt);
+            handle.destroy();
+        }
+        T await_resume() noexcept { return *static_cast<Self &&>(self); }
     };
 
-    Awaiter operator co_await() const & { return Awaiter{*this}; }
-    Awaiter operator co_await() && { return Awaiter{std::move(*this)}; }
-
-    optional(promise_type &promise) { promise.resultObject = this; }
-
-    // Because we must not have a trivially copyable object, else it is allowed to passed by registers
-    constexpr ~optional() {}
+    Awaiter<const optional &> operator co_await() const & { return {*this}; }
+    Awaiter<optional> operator co_await() && { return {std::move(*this)}; }
 #endif
 
     template <typename U = T>
@@ -0,0 +1,433 @@
+/**
+ * @file serialize.h
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "StrongType.h"
+#include "Tuple.h"
+#include "optional.h"
+
+namespace ltl {
+
+/**
+ *\defgroup Utils Utilitary group
+ *@{
+ */
+
+/**
+ * @brief varint - An integer serialized with a variable number of bytes
+ *
+ * 7 bits per byte: small values take less space than their fixed size. Signed integers are zigzag encoded, so small
+ * negative values are small too.
+ *
+ * @code
+ *  ltl::tuple_t<ltl::varint<std::uint64_t>, std::string> message{{id}, name};
+ * @endcode
+ */
+template <typename T>
+struct varint {
+    static_assert(std::is_integral_v<T>, "varint needs an integer");
+    T value{};
+
+    friend bool operator==(const varint &a, const varint &b) noexcept { return a.value == b.value; }
+};
+
+template <typename T>
+varint(T) -> varint<T>;
+
+/**
+ * @brief serializer - How a type is serialized
+ *
+ * It may be specialized for other types, with the same three static functions:
+ *
+ * @code
+ *  template <>
+ *  struct ltl::serializer<Point> {
+ *      static std::size_t size(const Point &p) noexcept;
+ *      static void write(const Point &p, std::uint8_t *&out) noexcept;
+ *      static bool read(Point &p, ltl::serialization_reader &in);
+ *  };
+ * @endcode
+ */
+template <typename T, typename = void>
+struct serializer;
+
+/**
+ * @brief serialization_reader - The bytes remaining to be deserialized
+ */
+struct serialization_reader {
+    const std::uint8_t *first;
+    const std::uint8_t *last;
+
+    std::size_t remaining() const noexcept { return static_cast<std::size_t>(last - first); }
+
+    bool copy(void *destination, std::size_t n) noexcept {
+        if (remaining() < n)
+            return false;
+        std::memcpy(destination, first, n);
+        first += n;
+        return true;
+    }
+};
+
+/// \cond
+
+namespace details {
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr bool is_little_endian = false;
+#else
+constexpr bool is_little_endian = true;
+#endif
+
+template <typename T, typename = void>
+struct is_bitwise_serializable : bool_t<is_little_endian && ((std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) ||
+                                                             std::is_enum_v<T>)> {};
+
+template <typename T, std::size_t N>
+struct is_bitwise_serializable<std::array<T, N>> :
+    bool_t<is_bitwise_serializable<T>::value && sizeof(std::array<T, N>) == N * sizeof(T)> {};
+
+template <typename T, typename Tag, typename Converter, template <typename...> typename... Skills>
+struct is_bitwise_serializable<detail::strong_type_t<T, Tag, Converter, Skills...>> :
+    bool_t<is_bitwise_serializable<T>::value && sizeof(detail::strong_type_t<T, Tag, Converter, Skills...>) ==
+                                                    sizeof(T)> {};
+
+// The serialized bytes of T are its bytes in memory: arrays of T are copied at once
+template <typename T>
+constexpr bool IsBitwiseSerializable = is_bitwise_serializable<T>::value;
+
+template <typename T>
+std::size_t varint_size(T value) noexcept {
+    std::size_t size = 1;
+    for (; value >= 0x80; value >>= 7)
+        ++size;
+    return size;
+}
+
+template <typename T>
+void write_varint(T value, std::uint8_t *&out) noexcept {
+    for (; value >= 0x80; value >>= 7)
+        *out++ = static_cast<std::uint8_t>(value | 0x80);
+    *out++ = static_cast<std::uint8_t>(value);
+}
+
+template <typename T>
+bool read_varint(T &value, serialization_reader &in) noexcept {
+    value = 0;
+    for (unsigned shift = 0; shift < sizeof(T) * 8; shift += 7) {
+        if (in.first == in.last)
+            return false;
+        const std::uint8_t byte = *in.first++;
+        value |= static_cast<T>(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+template <typename T>
+std::size_t serialized_size(const T &value) noexcept {
+    return serializer<T>::size(value);
+}
+
+template <typename T>
+void write(const T &value, std::uint8_t *&out) noexcept {
+    serializer<T>::write(value, out);
+}
+
+template <typename T>
+bool read(T &value, serialization_reader &in) {
+    return serializer<T>::read(value, in);
+}
+
+// Elements of an array, a vector or a string
+template <typename T>
+std::size_t elements_size(const T *first, std::size_t n) noexcept {
+    if constexpr (IsBitwiseSerializable<T>) {
+        return n * sizeof(T);
+    } else {
+        std::size_t size = 0;
+        for (std::size_t i = 0; i < n; ++i)
+            size += details::serialized_size(first[i]);
+        return size;
+    }
+}
+
+template <typename T>
+void write_elements(const T *first, std::size_t n, std::uint8_t *&out) noexcept {
+    if constexpr (IsBitwiseSerializable<T>) {
+        if (n) {
+            std::memcpy(out, first, n * sizeof(T));
+            out += n * sizeof(T);
+        }
+    } else {
+        for (std::size_t i = 0; i < n; ++i)
+            details::write(first[i], out);
+    }
+}
+
+template <typename T>
+bool read_elements(T *first, std::size_t n, serialization_reader &in) {
+    if constexpr (IsBitwiseSerializable<T>) {
+        return n == 0 || in.copy(first, n * sizeof(T));
+    } else {
+        for (std::size_t i = 0; i < n; ++i) {
+            if (!details::read(first[i], in))
+                return false;
+        }
+        return true;
+    }
+}
+
+// A vector or a string: the number of elements as a varint, then the elements
+template <typename Container>
+struct sequence_serializer {
+    using value_type = typename Container::value_type;
+
+    static std::size_t size(const Container &c) noexcept {
+        return varint_size(c.size()) + elements_size(c.data(), c.size());
+    }
+
+    static void write(const Container &c, std::uint8_t *&out) noexcept {
+        write_varint(c.size(), out);
+        write_elements(c.data(), c.size(), out);
+    }
+
+    static bool read(Container &c, serialization_reader &in) {
+        std::size_t n;
+        // Each element takes at least one byte: a corrupted size must not allocate more than the input
+        if (!read_varint(n, in) || n > in.remaining())
+            return false;
+        c.resize(n);
+        return read_elements(c.data(), n, in);
+    }
+};
+
+} // namespace details
+
+template <typename T>
+struct serializer<T, std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>>> {
+    static constexpr std::size_t size(const T &) noexcept { return sizeof(T); }
+
+    static void write(const T &value, std::uint8_t *&out) noexcept {
+        if constexpr (std::is_same_v<T, bool>) {
+            *out++ = value;
+        } else if constexpr (details::is_little_endian) {
+            std::memcpy(out, &value, sizeof(T));
+            out += sizeof(T);
+        } else {
+            const auto *bytes = reinterpret_cast<const std::uint8_t *>(&value);
+            for (std::size_t i = sizeof(T); i-- > 0;)
+                *out++ = bytes[i];
+        }
+    }
+
+    static bool read(T &value, serialization_reader &in) noexcept {
+        if constexpr (std::is_same_v<T, bool>) {
+            std::uint8_t byte;
+            if (!in.copy(&byte, 1))
+                return false;
+            value = byte != 0;
+            return true;
+        } else if constexpr (details::is_little_endian) {
+            return in.copy(&value, sizeof(T));
+        } else {
+            std::uint8_t bytes[sizeof(T)];
+            if (!in.copy(bytes, sizeof(T)))
+                return false;
+            auto *destination = reinterpret_cast<std::uint8_t *>(&value);
+            for (std::size_t i = 0; i < sizeof(T); ++i)
+                destination[i] = bytes[sizeof(T) - 1 - i];
+            return true;
+        }
+    }
+};
+
+template <typename T>
+struct serializer<varint<T>> {
+    using unsigned_type = std::make_unsigned_t<T>;
+
+    static unsigned_type encode(T value) noexcept {
+        if constexpr (std::is_signed_v<T>)
+            return (static_cast<unsigned_type>(value) << 1) ^ static_cast<unsigned_type>(value < 0 ? -1 : 0);
+        else
+            return value;
+    }
+
+    static std::size_t size(const varint<T> &v) noexcept { return details::varint_size(encode(v.value)); }
+
+    static void write(const varint<T> &v, std::uint8_t *&out) noexcept { details::write_varint(encode(v.value), out); }
+
+    static bool read(varint<T> &v, serialization_reader &in) noexcept {
+        unsigned_type value;
+        if (!details::read_varint(value, in))
+            return false;
+        if constexpr (std::is_signed_v<T>)
+            v.value = static_cast<T>((value >> 1) ^ (~(value & 1) + 1));
+        else
+            v.value = value;
+        return true;
+    }
+};
+
+template <typename T, typename Tag, typename Converter, template <typename...> typename... Skills>
+struct serializer<detail::strong_type_t<T, Tag, Converter, Skills...>> {
+    using type = detail::strong_type_t<T, Tag, Converter, Skills...>;
+
+    static std::size_t size(const type &value) noexcept { return details::serialized_size(value.get()); }
+    static void write(const type &value, std::uint8_t *&out) noexcept { details::write(value.get(), out); }
+    static bool read(type &value, serialization_reader &in) { return details::read(value.get(), in); }
+};
+
+template <typename T, std::size_t N>
+struct serializer<std::array<T, N>> {
+    static std::size_t size(const std::array<T, N> &a) noexcept { return details::elements_size(a.data(), N); }
+    static void write(const std::array<T, N> &a, std::uint8_t *&out) noexcept {
+        details::write_elements(a.data(), N, out);
+    }
+    static bool read(std::array<T, N> &a, serialization_reader &in) { return details::read_elements(a.data(), N, in); }
+};
+
+template <typename T, typename Allocator>
+struct serializer<std::vector<T, Allocator>> : details::sequence_serializer<std::vector<T, Allocator>> {
+    static_assert(!std::is_same_v<T, bool>, "std::vector<bool> is not serializable");
+};
+
+template <typename Char, typename Traits, typename Allocator>
+struct serializer<std::basic_string<Char, Traits, Allocator>> :
+    details::sequence_serializer<std::basic_string<Char, Traits, Allocator>> {};
+
+template <>
+struct serializer<std::monostate> {
+    static constexpr std::size_t size(const std::monostate &) noexcept { return 0; }
+    static void write(const std::monostate &, std::uint8_t *&) noexcept {}
+    static bool read(std::monostate &, serialization_reader &) noexcept { return true; }
+};
+
+template <typename... Ts>
+struct serializer<std::variant<Ts...>> {
+    using type = std::variant<Ts...>;
+
+    static std::size_t size(const type &v) noexcept {
+        return details::varint_size(v.index()) +
+               std::visit([](const auto &x) { return details::serialized_size(x); }, v);
+    }
+
+    static void write(const type &v, std::uint8_t *&out) noexcept {
+        details::write_varint(v.index(), out);
+        std::visit([&out](const auto &x) { details::write(x, out); }, v);
+    }
+
+    static bool read(type &v, serialization_reader &in) {
+        std::size_t index;
+        if (!details::read_varint(index, in) || index >= sizeof...(Ts))
+            return false;
+        return read_alternative(v, index, in, std::index_sequence_for<Ts...>{});
+    }
+
+  private:
+    template <std::size_t... Is>
+    static bool read_alternative(type &v, std::size_t index, serialization_reader &in, std::index_sequence<Is...>) {
+        bool result = false;
+        ((Is == index && (result = details::read(v.template emplace<Is>(), in), true)) || ...);
+        return result;
+    }
+};
+
+template <typename Tuple>
+struct serializer<Tuple, std::enable_if_t<IsTuple<Tuple>>> {
+    static std::size_t size(const Tuple &t) noexcept {
+        return t([](const auto &...xs) { return (std::size_t{0} + ... + details::serialized_size(xs)); });
+    }
+
+    static void write(const Tuple &t, std::uint8_t *&out) noexcept {
+        t([&out](const auto &...xs) { (details::write(xs, out), ...); });
+    }
+
+    static bool read(Tuple &t, serialization_reader &in) {
+        return t([&in](auto &...xs) { return (details::read(xs, in) && ...); });
+    }
+};
+
+/// \endcond
+
+/**
+ * @brief serialized_size - The number of bytes written by serialize
+ */
+template <typename T>
+std::size_t serialized_size(const T &value) noexcept {
+    return details::serialized_size(value);
+}
+
+/**
+ * @brief serialize - Writes value into a buffer of at least serialized_size(value) bytes, returns the end of the
+ * written bytes
+ *
+ * The supported types are integers, floating points and enums (little endian), `ltl::varint`, `ltl::strong_type_t`,
+ * `ltl::tuple_t`, `ltl::TypedTuple`, `std::array`, `std::vector`, `std::string` and `std::variant`. The sizes of the
+ * containers and the index of the variants are varints. The arrays of integers or floating points are copied at once.
+ *
+ * @code
+ *  using Id = ltl::strong_type_t<std::uint64_t, struct IdTag>;
+ *  using Message = ltl::tuple_t<Id, std::string, std::vector<double>>;
+ *
+ *  Message message{Id{1u}, "values"s, std::vector<double>{1.0, 2.0}};
+ *  std::vector<std::uint8_t> buffer(ltl::serialized_size(message));
+ *  ltl::serialize(message, buffer.data());
+ *
+ *  auto bytes = ltl::serialize(message); // the same, in a new vector
+ *  ltl::optional<Message> decoded = ltl::deserialize<Message>(bytes);
+ * @endcode
+ */
+template <typename T>
+std::uint8_t *serialize(const T &value, std::uint8_t *out) noexcept {
+    details::write(value, out);
+    return out;
+}
+
+/**
+ * @brief serialize - Returns the serialized bytes of value in a vector allocated once
+ */
+template <typename T>
+std::vector<std::uint8_t> serialize(const T &value) {
+    std::vector<std::uint8_t> buffer(serialized_size(value));
+    serialize(value, buffer.data());
+    return buffer;
+}
+
+/**
+ * @brief deserialize - Reads value from [first, last), returns the end of the read bytes or nullptr if the bytes
+ * are invalid
+ */
+template <typename T>
+const std::uint8_t *deserialize(T &value, const std::uint8_t *first, const std::uint8_t *last) {
+    serialization_reader in{first, last};
+    return details::read(value, in) ? in.first : nullptr;
+}
+
+/**
+ * @brief deserialize - Reads a T from all the bytes, returns nullopt if the bytes are invalid or not all used
+ */
+template <typename T>
+ltl::optional<T> deserialize(const std::vector<std::uint8_t> &bytes) {
+    // ltl::optional has no move constructor: the result is built once, when it is returned
+    T value{};
+    serialization_reader in{bytes.data(), bytes.data() + bytes.size()};
+    if (!details::read(value, in) || in.first != in.last)
+        return std::nullopt;
+    return ltl::optional<T>{std::move(value)};
+}
+
+/// @}
+
+} // namespace ltl
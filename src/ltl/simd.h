@@ -0,0 +1,292 @@
+/**
+ * @file simd.h
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#include "Range/BaseIterator.h"
+
+#if defined(__GNUC__)
+#define LTL_SIMD_VECTOR_EXTENSIONS 1
+#define LTL_SIMD_ALWAYS_INLINE __attribute__((always_inline)) inline
+#else
+#define LTL_SIMD_VECTOR_EXTENSIONS 0
+#define LTL_SIMD_ALWAYS_INLINE inline
+#endif
+
+#if LTL_SIMD_VECTOR_EXTENSIONS && (defined(__x86_64__) || defined(__i386__))
+#define LTL_SIMD_RUNTIME_DISPATCH 1
+#include <immintrin.h>
+#else
+#define LTL_SIMD_RUNTIME_DISPATCH 0
+#endif
+
+namespace ltl {
+
+/// \cond
+
+namespace details {
+
+constexpr bool is_constant_evaluated() noexcept {
+#if defined(__cpp_lib_is_constant_evaluated)
+    return std::is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+
+// t == v, with the usual arithmetic conversions but without the signed / unsigned comparison warning
+template <typename T, typename V>
+constexpr bool same_value(const T &t, const V &v) noexcept {
+    using common_type = std::common_type_t<T, V>;
+    return static_cast<common_type>(t) == static_cast<common_type>(v);
+}
+
+template <typename T>
+constexpr bool IsSimdSearchableValue = std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+                                       (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+/**
+ * Searching or counting a value in a contiguous range of integers.
+ *
+ * Bytes are searched with memchr. Wider integers are compared by blocks of 16 bytes (SSE2) or 32 bytes (AVX2, if
+ * available at runtime): the comparison mask is turned into a bit mask where the bit `i * sizeof(T)` is set when the
+ * element `i` of the block is equal to the value.
+ */
+template <typename It, typename V>
+constexpr bool IsSimdSearchable = IsContiguousIterator<It> &&
+                                   IsSimdSearchableValue<typename std::iterator_traits<It>::value_type> &&
+                                   IsSimdSearchableValue<ltl::remove_cvref_t<V>>;
+
+#if LTL_SIMD_RUNTIME_DISPATCH
+
+template <typename T>
+LTL_SIMD_ALWAYS_INLINE __m128i broadcast_sse2(T value) noexcept {
+    if constexpr (sizeof(T) == 1)
+        return _mm_set1_epi8(static_cast<char>(value));
+    else if constexpr (sizeof(T) == 2)
+        return _mm_set1_epi16(static_cast<short>(value));
+    else if constexpr (sizeof(T) == 4)
+        return _mm_set1_epi32(static_cast<int>(value));
+    else
+        return _mm_set1_epi64x(static_cast<long long>(value));
+}
+
+template <typename T>
+LTL_SIMD_ALWAYS_INLINE unsigned equal_bits_sse2(const T *p, __m128i needle) noexcept {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    if constexpr (sizeof(T) == 1) {
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+    } else if constexpr (sizeof(T) == 2) {
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi16(block, needle))) & 0x5555u;
+    } else if constexpr (sizeof(T) == 4) {
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi32(block, needle))) & 0x1111u;
+    } else {
+        // SSE2 has no 64 bits comparison: both halves must be equal
+        const auto bits = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi32(block, needle)));
+        return bits & (bits >> 4) & 0x0101u;
+    }
+}
+
+template <typename T>
+__attribute__((target("avx2"))) unsigned equal_bits_avx2(const T *p, __m256i needle) noexcept {
+    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    if constexpr (sizeof(T) == 1) {
+        return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+    } else if constexpr (sizeof(T) == 2) {
+        return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(block, needle))) & 0x55555555u;
+    } else if constexpr (sizeof(T) == 4) {
+        return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi32(block, needle))) & 0x11111111u;
+    } else {
+        return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi64(block, needle))) & 0x01010101u;
+    }
+}
+
+template <typename T>
+const T *find_sse2(const T *first, const T *last, T value) noexcept {
+    constexpr std::ptrdiff_t lanes = 16 / sizeof(T);
+    const __m128i needle = broadcast_sse2(value);
+    for (; last - first >= lanes; first += lanes) {
+        if (const unsigned bits = equal_bits_sse2(first, needle))
+            return first + __builtin_ctz(bits) / sizeof(T);
+    }
+    return std::find(first, last, value);
+}
+
+template <typename T>
+__attribute__((target("avx2"))) const T *find_avx2(const T *first, const T *last, T value) noexcept {
+    constexpr std::ptrdiff_t lanes = 32 / sizeof(T);
+    const __m256i needle = _mm256_broadcastsi128_si256(broadcast_sse2(value));
+    for (; last - first >= lanes; first += lanes) {
+        if (const unsigned bits = equal_bits_avx2(first, needle))
+            return first + __builtin_ctz(bits) / sizeof(T);
+    }
+    return std::find(first, last, value);
+}
+
+template <typename T>
+std::size_t count_sse2(const T *first, const T *last, T value) noexcept {
+    constexpr std::ptrdiff_t lanes = 16 / sizeof(T);
+    const __m128i needle = broadcast_sse2(value);
+    std::size_t result = 0;
+    for (; last - first >= lanes; first += lanes)
+        result += __builtin_popcount(equal_bits_sse2(first, needle));
+    return result + std::count(first, last, value);
+}
+
+template <typename T>
+__attribute__((target("avx2,popcnt"))) std::size_t count_avx2(const T *first, const T *last, T value) noexcept {
+    constexpr std::ptrdiff_t lanes = 32 / sizeof(T);
+    const __m256i needle = _mm256_broadcastsi128_si256(broadcast_sse2(value));
+    std::size_t result = 0;
+    for (; last - first >= lanes; first += lanes)
+        result += __builtin_popcount(equal_bits_avx2(first, needle));
+    return result + std::count(first, last, value);
+}
+
+// Returns the first byte equal to one of bytes, or the beginning of the last incomplete block
+inline const char *find_any_sse2(const char *first, const char *last, const char *bytes, std::size_t count) noexcept {
+    __m128i needles[16];
+    for (std::size_t i = 0; i < count; ++i)
+        needles[i] = _mm_set1_epi8(bytes[i]);
+    for (; last - first >= 16; first += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+        __m128i equal = _mm_cmpeq_epi8(block, needles[0]);
+        for (std::size_t i = 1; i < count; ++i)
+            equal = _mm_or_si128(equal, _mm_cmpeq_epi8(block, needles[i]));
+        if (const int bits = _mm_movemask_epi8(equal))
+            return first + __builtin_ctz(bits);
+    }
+    return first;
+}
+
+__attribute__((target("avx2"))) inline const char *find_any_avx2(const char *first, const char *last,
+                                                                 const char *bytes, std::size_t count) noexcept {
+    __m256i needles[16];
+    for (std::size_t i = 0; i < count; ++i)
+        needles[i] = _mm256_set1_epi8(bytes[i]);
+    for (; last - first >= 32; first += 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+        __m256i equal = _mm256_cmpeq_epi8(block, needles[0]);
+        for (std::size_t i = 1; i < count; ++i)
+            equal = _mm256_or_si256(equal, _mm256_cmpeq_epi8(block, needles[i]));
+        if (const int bits = _mm256_movemask_epi8(equal))
+            return first + __builtin_ctz(bits);
+    }
+    return first;
+}
+
+#endif
+
+template <typename T>
+const T *find_contiguous(const T *first, const T *last, T value) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        const void *p = std::memchr(first, static_cast<unsigned char>(value), last - first);
+        return p ? static_cast<const T *>(p) : last;
+    } else {
+#if LTL_SIMD_RUNTIME_DISPATCH
+        if (__builtin_cpu_supports("avx2"))
+            return find_avx2(first, last, value);
+        return find_sse2(first, last, value);
+#else
+        return std::find(first, last, value);
+#endif
+    }
+}
+
+template <typename T>
+std::size_t count_contiguous(const T *first, const T *last, T value) noexcept {
+#if LTL_SIMD_RUNTIME_DISPATCH
+    if (__builtin_cpu_supports("avx2"))
+        return count_avx2(first, last, value);
+    return count_sse2(first, last, value);
+#else
+    return std::count(first, last, value);
+#endif
+}
+
+/**
+ * A set of bytes, like the delimiters of a text.
+ *
+ * find returns the first byte of [first, last) belonging to the set. Up to 16 bytes, blocks of 16 or 32 bytes are
+ * compared with every byte of the set; larger sets are searched byte per byte with a lookup table.
+ */
+class byte_set {
+  public:
+    static constexpr std::size_t simd_capacity = 16;
+
+    byte_set() noexcept = default;
+
+    template <typename It>
+    byte_set(It first, It last) noexcept {
+        for (; first != last; ++first) {
+            const auto byte = static_cast<unsigned char>(*first);
+            if (contains(byte))
+                continue;
+            m_table[byte / 64] |= std::uint64_t(1) << (byte % 64);
+            if (m_size < simd_capacity)
+                m_bytes[m_size] = static_cast<char>(byte);
+            ++m_size;
+        }
+    }
+
+    bool contains(unsigned char byte) const noexcept { return (m_table[byte / 64] >> (byte % 64)) & 1; }
+
+    std::size_t size() const noexcept { return m_size; }
+
+    const char *find(const char *first, const char *last) const noexcept {
+        if (m_size == 1) {
+            const void *p = std::memchr(first, static_cast<unsigned char>(m_bytes[0]), last - first);
+            return p ? static_cast<const char *>(p) : last;
+        }
+#if LTL_SIMD_RUNTIME_DISPATCH
+        if (m_size > 1 && m_size <= simd_capacity) {
+            first = __builtin_cpu_supports("avx2") ? find_any_avx2(first, last, m_bytes, m_size)
+                                                   : find_any_sse2(first, last, m_bytes, m_size);
+        }
+#endif
+        for (; first != last; ++first) {
+            if (contains(static_cast<unsigned char>(*first)))
+                return first;
+        }
+        return last;
+    }
+
+  private:
+    std::uint64_t m_table[4] = {};
+    char m_bytes[simd_capacity] = {};
+    std::size_t m_size = 0;
+};
+
+template <typename It, typename V>
+It simd_find(It first, It last, const V &v) {
+    using value_type = std::remove_cv_t<typename std::iterator_traits<It>::value_type>;
+    const auto value = static_cast<value_type>(v);
+    if (first == last || !same_value(value, v))
+        return std::find(first, last, v);
+    const value_type *p = std::addressof(*first);
+    return first + (find_contiguous(p, p + (last - first), value) - p);
+}
+
+template <typename It, typename V>
+auto simd_count(It first, It last, const V &v) {
+    using value_type = std::remove_cv_t<typename std::iterator_traits<It>::value_type>;
+    using difference_type = typename std::iterator_traits<It>::difference_type;
+    const auto value = static_cast<value_type>(v);
+    if (first == last || !same_value(value, v))
+        return std::count(first, last, v);
+    const value_type *p = std::addressof(*first);
+    return static_cast<difference_type>(count_contiguous(p, p + (last - first), value));
+}
+
+} // namespace details
+
+/// \endcond
+
+} // namespace ltl
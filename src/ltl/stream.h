@@ -3,8 +3,11 @@
  */
 #pragma once
 
+#include <cstring>
 #include <iostream>
 #include <iterator>
+#include <limits>
+#include <memory>
 #include <streambuf>
 
 #include "algos.h"
@@ -14,6 +17,27 @@ namespace ltl {
 using std::begin;
 using std::end;
 
+/// \cond
+namespace details {
+// The container may be used directly as the get or put area of the streambuf
+template <typename Container, typename Char,
+          typename T = ltl::remove_cvref_t<decltype(*begin(std::declval<Container &>()))>>
+constexpr bool IsStreamBufferArea = IsContiguousIterator<decltype(begin(std::declval<Container &>()))> &&
+                                    std::is_trivially_copyable_v<T> && sizeof(T) == sizeof(Char);
+
+template <typename Char, typename Container>
+Char *stream_buffer_data(Container &container) noexcept {
+    return reinterpret_cast<Char *>(std::data(container));
+}
+} // namespace details
+/// \endcond
+
+/**
+ * @brief basic_readonly_streambuf - A streambuf reading the elements of a container
+ *
+ * When the container is contiguous and its elements have the size of a character, the container is the get area of
+ * the streambuf: `std::istream` reads it without any virtual call, and `read` copies it with memcpy.
+ */
 template <typename Container, typename Char, typename Trait = std::char_traits<Char>>
 class basic_readonly_streambuf final : public std::basic_streambuf<Char, Trait> {
     using T = ltl::remove_cvref_t<decltype(*begin(std::declval<Container &>()))>;
@@ -22,6 +46,8 @@ class basic_readonly_streambuf final : public std::basic_streambuf<Char, Trait>
     using pos_type = typename Trait::pos_type;
     using off_type = typename Trait::off_type;
 
+    static constexpr bool has_get_area = details::IsStreamBufferArea<Container, Char>;
+
   public:
     basic_readonly_streambuf(Container container) noexcept : m_container{std::move(container)} { computeIterators(); }
 
@@ -29,11 +55,15 @@ class basic_readonly_streambuf final : public std::basic_streambuf<Char, Trait>
     template <typename OtherContainer>
     void feed(const OtherContainer &container) {
         using std::size;
-        const auto number = std::distance(m_begin, m_current);
-        m_container.reserve(m_container.size() + size(container));
-        ltl::copy(container, std::back_inserter(m_container));
+        const auto number = position();
+        if constexpr (has_get_area) {
+            m_container.insert(end(m_container), begin(container), end(container));
+        } else {
+            m_container.reserve(m_container.size() + size(container));
+            ltl::copy(container, std::back_inserter(m_container));
+        }
         computeIterators();
-        std::advance(m_current, number);
+        setPosition(number);
     }
 
     void clear() {
@@ -42,29 +72,33 @@ class basic_readonly_streambuf final : public std::basic_streambuf<Char, Trait>
     }
 
   protected:
-    std::streamsize showmanyc() override { return std::distance(m_current, m_end); }
+    std::streamsize showmanyc() override { return remaining(); }
 
     std::streamsize xsgetn(char_type *s, std::streamsize count) override {
-        if (showmanyc() < count)
-            return 0;
-        for (int i = 0; i < count; ++i) {
-            *s++ = static_cast<char_type>(*m_current++);
+        const std::streamsize n = std::min(count, remaining());
+        if constexpr (has_get_area) {
+            std::memcpy(s, this->gptr(), n * sizeof(char_type));
+            this->setg(this->eback(), this->gptr() + n, this->egptr());
+        } else {
+            for (std::streamsize i = 0; i < n; ++i) {
+                *s++ = static_cast<char_type>(*m_current++);
+            }
         }
-        return count;
+        return n;
     }
 
     int_type underflow() override {
-        if (m_current != m_end) {
-            return Trait::to_int_type(static_cast<char_type>(*m_current));
+        if (remaining() > 0) {
+            return Trait::to_int_type(static_cast<char_type>(*current()));
         } else {
             return Trait::eof();
         }
     }
 
     int_type uflow() override {
-        if (m_current != m_end) {
+        if (remaining() > 0) {
             auto result = underflow();
-            ++m_current;
+            setPosition(position() + 1);
             return result;
         } else {
             return Trait::eof();
@@ -74,12 +108,12 @@ class basic_readonly_streambuf final : public std::basic_streambuf<Char, Trait>
     pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode = std::ios_base::in) override {
         std::size_t offset;
         if (dir == std::ios_base::cur)
-            offset = std::distance(m_begin, m_current) + off;
+            offset = position() + off;
         else if (dir == std::ios_base::beg)
             offset = off;
         else
             offset = m_container.size() + off;
-        m_current = std::next(m_begin, offset);
+        setPosition(offset);
         return offset;
     }
 
@@ -89,12 +123,13 @@ class basic_readonly_streambuf final : public std::basic_streambuf<Char, Trait>
 
     int sync() override {
         auto is_erasable = IS_VALID((c), c.erase(m_begin, m_current));
+        auto current = this->current();
 
-        if_constexpr(is_erasable(m_container)) { m_container.erase(m_begin, m_current); }
+        if_constexpr(is_erasable(m_container)) { m_container.erase(m_begin, current); }
         else {
             Container newContainer;
-            newContainer.reserve(std::distance(m_current, m_end));
-            std::copy(m_current, m_end, std::back_inserter(newContainer));
+            newContainer.reserve(std::distance(current, m_end));
+            std::copy(current, m_end, std::back_inserter(newContainer));
             m_container = std::move(newContainer);
         }
         computeIterators();
@@ -102,9 +137,11 @@ class basic_readonly_streambuf final : public std::basic_streambuf<Char, Trait>
     }
 
     int_type pbackfail(int_type c = Trait::eof()) override {
-        --m_current;
+        if (position() == 0)
+            return Trait::eof();
+        setPosition(position() - 1);
         if (c != Trait::eof())
-            *m_current = static_cast<T>(Trait::to_char_type(c));
+            *current() = static_cast<T>(Trait::to_char_type(c));
         return 0;
     }
 
@@ -113,8 +150,35 @@ class basic_readonly_streambuf final : public std::basic_streambuf<Char, Trait>
         m_end = end(m_container);
         m_begin = begin(m_container);
         m_current = begin(m_container);
+        if constexpr (has_get_area) {
+            char_type *data = details::stream_buffer_data<char_type>(m_container);
+            this->setg(data, data, data + m_container.size());
+        }
     }
 
+    std::size_t position() const noexcept {
+        if constexpr (has_get_area)
+            return this->gptr() - this->eback();
+        else
+            return std::distance(m_begin, m_current);
+    }
+
+    void setPosition(std::size_t position) noexcept {
+        if constexpr (has_get_area)
+            this->setg(this->eback(), this->eback() + position, this->egptr());
+        else
+            m_current = std::next(m_begin, position);
+    }
+
+    std::streamsize remaining() const noexcept {
+        if constexpr (has_get_area)
+            return this->egptr() - this->gptr();
+        else
+            return std::distance(m_current, m_end);
+    }
+
+    auto current() const noexcept { return std::next(m_begin, position()); }
+
   private:
     Container m_container;
     decltype(begin(m_container)) m_begin;
@@ -122,34 +186,272 @@ class basic_readonly_streambuf final : public std::basic_streambuf<Char, Trait>
     decltype(end(m_container)) m_end;
 };
 
+/**
+ * @brief basic_writeonly_streambuf - A streambuf appending characters to a container
+ *
+ * When the container is contiguous and its elements have the size of a character, the unused capacity of the
+ * container is the put area of the streambuf: `std::ostream` writes there without any virtual call, and `write` copies
+ * with memcpy. The container is cut to the written size before being given back.
+ */
 template <typename Container, typename Char, typename Trait = std::char_traits<Char>>
 class basic_writeonly_streambuf final : public std::basic_streambuf<Char, Trait> {
     using T = ltl::remove_cvref_t<decltype(*begin(std::declval<Container &>()))>;
     using char_type = typename Trait::char_type;
     using int_type = typename Trait::int_type;
 
+    static constexpr bool has_put_area = details::IsStreamBufferArea<Container, Char>;
+
   public:
-    Container takeContainer() noexcept { return std::move(m_container); }
-    const Container &getContainer() const noexcept { return m_container; }
+    Container takeContainer() noexcept {
+        closePutArea();
+        return std::move(m_container);
+    }
+
+    // The container holds the characters written before the call, the next write opens the put area again. The put
+    // area only tracks the written size, so closing it does not change the observable state of the streambuf.
+    const Container &getContainer() const noexcept {
+        const_cast<basic_writeonly_streambuf &>(*this).closePutArea();
+        return m_container;
+    }
 
   protected:
     std::streamsize xsputn(const typename Trait::char_type *s, std::streamsize count) override {
-        m_container.reserve(m_container.size() + count);
-        for (int i = 0; i < count; ++i)
-            m_container.push_back(static_cast<T>(*s++));
+        if constexpr (has_put_area) {
+            if (this->epptr() - this->pptr() >= count) {
+                std::memcpy(this->pptr(), s, count * sizeof(char_type));
+                advancePutArea(count);
+            } else {
+                closePutArea();
+                const T *first = reinterpret_cast<const T *>(s);
+                m_container.insert(end(m_container), first, first + count);
+                openPutArea();
+            }
+        } else {
+            m_container.reserve(m_container.size() + count);
+            for (std::streamsize i = 0; i < count; ++i)
+                m_container.push_back(static_cast<T>(*s++));
+        }
         return count;
     }
 
     int_type overflow(int_type ch = Trait::eof()) override {
+        closePutArea();
         if (ch != Trait::eof())
             m_container.push_back(static_cast<T>(Trait::to_char_type(ch)));
+        openPutArea();
         return 0;
     }
 
+  private:
+    // The whole capacity of the container is used, the characters are written after the current size
+    void openPutArea() {
+        if constexpr (has_put_area) {
+            const std::size_t size = m_container.size();
+            m_container.resize(m_container.capacity());
+            char_type *data = details::stream_buffer_data<char_type>(m_container);
+            this->setp(data, data + m_container.size());
+            advancePutArea(size);
+        }
+    }
+
+    void closePutArea() {
+        if constexpr (has_put_area) {
+            if (this->pbase()) {
+                m_container.resize(this->pptr() - this->pbase());
+                this->setp(nullptr, nullptr);
+            }
+        }
+    }
+
+    void advancePutArea(std::size_t n) noexcept {
+        constexpr std::size_t maxStep = std::numeric_limits<int>::max();
+        for (; n > maxStep; n -= maxStep)
+            this->pbump(static_cast<int>(maxStep));
+        this->pbump(static_cast<int>(n));
+    }
+
   private:
     Container m_container;
 };
 
+/**
+ * @brief basic_ring_streambuf - A streambuf reading from a fixed capacity ring buffer
+ *
+ * The capacity is rounded up to a power of two. The bytes are written in place: `prepare` gives the free contiguous
+ * space, where a socket can read directly, and `commit` makes the written characters readable. `feed` copies a
+ * container the same way.
+ *
+ * Like `basic_readonly_streambuf`, reading does not free the space: the stream can seek back to retry an incomplete
+ * message. `pubsync` frees the characters already read, in constant time, without moving anything.
+ *
+ * The positions given by `tellg` count the characters since the creation of the streambuf.
+ *
+ * @code
+ *  ltl::ring_streambuf buffer{1 << 20};
+ *  std::istream stream(&buffer);
+ *  while (connected) {
+ *      auto space = buffer.prepare();
+ *      buffer.commit(read(socket, space.begin(), space.size()));
+ *      while (stream >> message)
+ *          process(message);
+ *      stream.clear();
+ *  }
+ * @endcode
+ */
+template <typename Char, typename Trait = std::char_traits<Char>>
+class basic_ring_streambuf final : public std::basic_streambuf<Char, Trait> {
+    using char_type = typename Trait::char_type;
+    using int_type = typename Trait::int_type;
+    using pos_type = typename Trait::pos_type;
+    using off_type = typename Trait::off_type;
+
+  public:
+    explicit basic_ring_streambuf(std::size_t capacity) :
+        m_capacity{roundCapacity(capacity)}, m_data{std::make_unique<char_type[]>(m_capacity)} {
+        setGetArea(0);
+    }
+
+    std::size_t capacity() const noexcept { return m_capacity; }
+
+    /**
+     * @brief prepare - Returns the free contiguous space after the written characters
+     *
+     * It may be smaller than the whole free space when the space wraps at the end of the ring.
+     */
+    Range<char_type *> prepare() noexcept {
+        const std::size_t offset = m_written & mask();
+        const std::size_t size = std::min(m_capacity - (m_written - m_released), m_capacity - offset);
+        return Range<char_type *>{m_data.get() + offset, m_data.get() + offset + size};
+    }
+
+    /**
+     * @brief commit - Makes the n first characters of the space given by prepare readable
+     */
+    void commit(std::size_t n) noexcept {
+        assert(n <= prepare().size());
+        const std::size_t read = readPosition();
+        m_written += n;
+        setGetArea(read);
+    }
+
+    /**
+     * @brief feed - Copies as many characters of the container as the free space allows, returns how many were copied
+     */
+    template <typename Container>
+    std::size_t feed(const Container &container) {
+        auto it = begin(container);
+        const auto last = end(container);
+        std::size_t copied = 0;
+        for (auto space = prepare(); it != last && !space.empty(); space = prepare()) {
+            std::size_t n = 0;
+            if constexpr (IsRandomAccessIterator<decltype(it)>) {
+                n = std::min<std::size_t>(space.size(), last - it);
+                if constexpr (std::is_same_v<ltl::remove_cvref_t<decltype(*it)>, char_type>)
+                    std::copy(it, it + n, space.begin());
+                else
+                    std::transform(it, it + n, space.begin(), [](const auto &c) { return static_cast<char_type>(c); });
+                it += n;
+            } else {
+                for (auto out = space.begin(); it != last && out != space.end(); ++it, ++out, ++n)
+                    *out = static_cast<char_type>(*it);
+            }
+            commit(n);
+            copied += n;
+        }
+        return copied;
+    }
+
+  protected:
+    std::streamsize showmanyc() override { return m_written - readPosition(); }
+
+    int_type underflow() override {
+        const std::size_t read = readPosition();
+        if (read == m_written)
+            return Trait::eof();
+        // The readable characters continue at the beginning of the ring
+        setGetArea(read);
+        return Trait::to_int_type(*this->gptr());
+    }
+
+    std::streamsize xsgetn(char_type *s, std::streamsize count) override {
+        std::streamsize n = 0;
+        while (n < count && (this->gptr() != this->egptr() || underflow() != Trait::eof())) {
+            const std::streamsize size = std::min<std::streamsize>(count - n, this->egptr() - this->gptr());
+            std::memcpy(s + n, this->gptr(), size * sizeof(char_type));
+            this->setg(this->eback(), this->gptr() + size, this->egptr());
+            n += size;
+        }
+        return n;
+    }
+
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode = std::ios_base::in) override {
+        std::size_t position;
+        if (dir == std::ios_base::cur)
+            position = readPosition() + off;
+        else if (dir == std::ios_base::beg)
+            position = off;
+        else
+            position = m_written + off;
+        if (position < m_released || position > m_written)
+            return pos_type(off_type(-1));
+        setGetArea(position);
+        return position;
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode = std::ios_base::in) override {
+        return seekoff(pos, std::ios_base::beg);
+    }
+
+    int sync() override {
+        const std::size_t read = readPosition();
+        m_released = read;
+        setGetArea(read);
+        return 0;
+    }
+
+    int_type pbackfail(int_type c = Trait::eof()) override {
+        const std::size_t read = readPosition();
+        if (read == m_released)
+            return Trait::eof();
+        setGetArea(read - 1);
+        if (c != Trait::eof())
+            *this->gptr() = Trait::to_char_type(c);
+        return Trait::not_eof(c);
+    }
+
+  private:
+    static std::size_t roundCapacity(std::size_t capacity) noexcept {
+        std::size_t result = 1;
+        while (result < capacity)
+            result *= 2;
+        return result;
+    }
+
+    std::size_t mask() const noexcept { return m_capacity - 1; }
+
+    std::size_t readPosition() const noexcept { return m_areaPosition + (this->gptr() - this->eback()); }
+
+    // The get area is the contiguous part of the ring around the position, from the released characters to the
+    // written ones
+    void setGetArea(std::size_t position) noexcept {
+        const std::size_t offset = position & mask();
+        const std::size_t before = std::min(position - m_released, offset);
+        const std::size_t after = std::min(m_written - position, m_capacity - offset);
+        char_type *current = m_data.get() + offset;
+        m_areaPosition = position - before;
+        this->setg(current - before, current, current + after);
+    }
+
+  private:
+    std::size_t m_capacity;
+    std::unique_ptr<char_type[]> m_data;
+    std::size_t m_released = 0;
+    std::size_t m_written = 0;
+    std::size_t m_areaPosition = 0;
+};
+
+using ring_streambuf = basic_ring_streambuf<char>;
+
 template <typename Container>
 using writeonly_streambuf = basic_writeonly_streambuf<Container, char>;
 
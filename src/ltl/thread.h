@@ -1,8 +1,24 @@
 #pragma once
 
 #include "ltl.h"
+#include "coroutine_helpers.h"
 #include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <deque>
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+#include <future>
+#include <functional>
 #include <shared_mutex>
+#include <type_traits>
+#include <condition_variable>
 
 namespace ltl {
 /**
@@ -10,11 +26,211 @@ namespace ltl {
  *@{
  */
 
+/// \cond
+namespace details {
+inline void cpu_relax() noexcept {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_ia32_pause();
+#elif defined(__GNUC__) && (defined(__aarch64__) || defined(__arm__))
+    asm volatile("yield");
+#endif
+}
+} // namespace details
+/// \endcond
+
+/**
+ * @brief spin_mutex - A mutex that never sleeps, for the critical sections of a few instructions
+ *
+ * While the mutex is taken, the waiters only read it, and they wait twice longer after each failed attempt, before
+ * yielding their time slice.
+ */
+class spin_mutex {
+    static constexpr unsigned max_spins = 64;
+
+  public:
+    void lock() noexcept {
+        unsigned spins = 1;
+        while (!try_lock()) {
+            while (m_locked.load(std::memory_order_relaxed)) {
+                if (spins <= max_spins) {
+                    for (unsigned i = 0; i < spins; ++i)
+                        details::cpu_relax();
+                    spins *= 2;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    }
+
+    bool try_lock() noexcept {
+        return !m_locked.load(std::memory_order_relaxed) && !m_locked.exchange(true, std::memory_order_acquire);
+    }
+
+    void unlock() noexcept { m_locked.store(false, std::memory_order_release); }
+
+  private:
+    std::atomic<bool> m_locked{false};
+};
+
+/**
+ * @brief The lock policies of ltl::mutex
+ *
+ *  - exclusive_policy: a std::mutex, the readers wait for each other
+ *  - shared_policy: a std::shared_mutex, the readers share the lock
+ *  - spin_policy: a spin_mutex, for the very short critical sections
+ *  - seqlock_policy: the writers take a spin_mutex, the readers never wait for each other nor block the writers. They
+ *    copy the value and start again if it was written meanwhile, so T must be trivially copyable and the function
+ *    should be cheap.
+ */
+struct exclusive_policy {
+    using mutex_type = std::mutex;
+};
+
+struct shared_policy {
+    using mutex_type = std::shared_mutex;
+};
+
+struct spin_policy {
+    using mutex_type = spin_mutex;
+};
+
+struct seqlock_policy {
+    using mutex_type = spin_mutex;
+};
+
+/**
+ * @brief mutex_statistics - What a mutex_telemetry measured
+ */
+struct mutex_statistics {
+    std::uint64_t acquisitions = 0;
+    // The acquisitions that had to wait, and for the seqlock, the reads that had to start again
+    std::uint64_t contentions = 0;
+    std::chrono::nanoseconds wait_time{0};
+    std::chrono::nanoseconds hold_time{0};
+};
+
+/**
+ * @brief no_telemetry - The default telemetry of ltl::mutex, that does not measure anything
+ */
+struct no_telemetry {
+    static constexpr bool enabled = false;
+};
+
+/**
+ * @brief mutex_telemetry - Counts the acquisitions, the contentions, the time spent waiting and the time spent holding
+ * the lock of an ltl::mutex
+ *
+ * The counters are relaxed atomics, and the clock is only read when the telemetry is enabled.
+ */
+class mutex_telemetry {
+  public:
+    static constexpr bool enabled = true;
+
+    void record(bool contended, std::chrono::nanoseconds wait, std::chrono::nanoseconds hold) noexcept {
+        m_acquisitions.fetch_add(1, std::memory_order_relaxed);
+        if (contended)
+            m_contentions.fetch_add(1, std::memory_order_relaxed);
+        m_waitTime.fetch_add(wait.count(), std::memory_order_relaxed);
+        m_holdTime.fetch_add(hold.count(), std::memory_order_relaxed);
+    }
+
+    mutex_statistics statistics() const noexcept {
+        return {m_acquisitions.load(std::memory_order_relaxed), m_contentions.load(std::memory_order_relaxed),
+                std::chrono::nanoseconds{m_waitTime.load(std::memory_order_relaxed)},
+                std::chrono::nanoseconds{m_holdTime.load(std::memory_order_relaxed)}};
+    }
+
+    void reset() noexcept {
+        m_acquisitions.store(0, std::memory_order_relaxed);
+        m_contentions.store(0, std::memory_order_relaxed);
+        m_waitTime.store(0, std::memory_order_relaxed);
+        m_holdTime.store(0, std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic<std::uint64_t> m_acquisitions{0};
+    std::atomic<std::uint64_t> m_contentions{0};
+    std::atomic<std::int64_t> m_waitTime{0};
+    std::atomic<std::int64_t> m_holdTime{0};
+};
+
+/// \cond
+namespace details {
+template <typename T, typename Policy>
+class mutex_value {
+  protected:
+    T m_value;
+};
+
+// The seqlock readers copy the value while a writer may modify it, so it is stored in words that are only accessed
+// with relaxed atomics. The sequence tells the readers if their copy is consistent.
 template <typename T>
+class mutex_value<T, seqlock_policy> {
+    using word = std::uintptr_t;
+    static constexpr std::size_t word_count = (sizeof(T) + sizeof(word) - 1) / sizeof(word);
+    static_assert(std::atomic<word>::is_always_lock_free, "A seqlock needs lock free atomic words");
+
+  protected:
+    // A copy of the value: T may not be default constructible, so it lives in raw bytes, where memcpy creates it
+    struct snapshot {
+        T &value() noexcept { return *std::launder(reinterpret_cast<T *>(bytes)); }
+
+        alignas(T) alignas(word) unsigned char bytes[word_count * sizeof(word)];
+    };
+
+    mutex_value() {
+        snapshot copy;
+        new (copy.bytes) T{};
+        store(copy);
+    }
+
+    void load(snapshot &copy) const noexcept {
+        for (std::size_t i = 0; i < word_count; ++i) {
+            const word w = m_words[i].load(std::memory_order_relaxed);
+            std::memcpy(copy.bytes + i * sizeof(word), &w, sizeof(word));
+        }
+    }
+
+    void store(const snapshot &copy) noexcept {
+        for (std::size_t i = 0; i < word_count; ++i) {
+            word w;
+            std::memcpy(&w, copy.bytes + i * sizeof(word), sizeof(word));
+            m_words[i].store(w, std::memory_order_relaxed);
+        }
+    }
+
+    std::atomic<std::uint64_t> m_sequence{0};
+
+  private:
+    std::atomic<word> m_words[word_count];
+};
+
+// An empty telemetry is a base class, so it takes no space
+template <typename Telemetry, typename = void>
+class mutex_telemetry_storage {
+  protected:
+    Telemetry &get_telemetry() const noexcept { return m_telemetry; }
+
+  private:
+    mutable Telemetry m_telemetry;
+};
+
+template <typename Telemetry>
+class mutex_telemetry_storage<Telemetry, std::enable_if_t<std::is_empty_v<Telemetry>>> : private Telemetry {
+  protected:
+    // An empty telemetry has no state to modify
+    Telemetry &get_telemetry() const noexcept { return const_cast<mutex_telemetry_storage &>(*this); }
+};
+} // namespace details
+/// \endcond
+
+template <typename T, typename Policy = shared_policy, typename Telemetry = no_telemetry>
 /**
  * @brief The Mutex class
  *
- * This class is done to protect a variable via mutual exclusion
+ * This class is done to protect a variable via mutual exclusion. The policy chooses the lock (see `shared_policy`),
+ * and `mutex_telemetry` measures the contention of each instance.
  *
  * @code
  *  int myVariable;
@@ -27,32 +243,561 @@ template <typename T>
  *  std::as_const(variable).with_lock([&](auto &value) {
  *      use(value); // here value is a const int&
  *  });
+ *
+ *  ltl::mutex<std::vector<Job>, ltl::exclusive_policy, ltl::mutex_telemetry> jobs;
+ *  ltl::mutex_statistics statistics = jobs.telemetry().statistics();
+ *
+ *  ltl::mutex<Position, ltl::seqlock_policy> position;
  * @endcode
  */
-class mutex {
+class mutex : private details::mutex_value<T, Policy>, private details::mutex_telemetry_storage<Telemetry> {
+    static_assert(!std::is_same_v<Policy, seqlock_policy> || std::is_trivially_copyable_v<T>,
+                  "A seqlock can only protect a trivially copyable value");
+
+    static constexpr bool is_shared = std::is_same_v<Policy, shared_policy>;
+    static constexpr bool is_seqlock = std::is_same_v<Policy, seqlock_policy>;
+
+    using clock = std::chrono::steady_clock;
+
+    // Takes the lock, and measures the waiting and holding times if the telemetry is enabled
+    template <bool Shared>
+    class guard {
+      public:
+        explicit guard(const mutex &m) : m_owner{m} {
+            if constexpr (Telemetry::enabled) {
+                const auto start = clock::now();
+                m_contended = !try_lock();
+                if (m_contended)
+                    lock();
+                m_locked = clock::now();
+                m_wait = m_locked - start;
+            } else {
+                lock();
+            }
+        }
+
+        guard(const guard &) = delete;
+        guard &operator=(const guard &) = delete;
+
+        ~guard() {
+            if constexpr (Telemetry::enabled) {
+                const auto hold = clock::now() - m_locked;
+                unlock();
+                m_owner.get_telemetry().record(m_contended, m_wait, hold);
+            } else {
+                unlock();
+            }
+        }
+
+      private:
+        bool try_lock() const {
+            if constexpr (Shared)
+                return m_owner.m_mutex.try_lock_shared();
+            else
+                return m_owner.m_mutex.try_lock();
+        }
+
+        void lock() const {
+            if constexpr (Shared)
+                m_owner.m_mutex.lock_shared();
+            else
+                m_owner.m_mutex.lock();
+        }
+
+        void unlock() const {
+            if constexpr (Shared)
+                m_owner.m_mutex.unlock_shared();
+            else
+                m_owner.m_mutex.unlock();
+        }
+
+        const mutex &m_owner;
+        bool m_contended = false;
+        clock::time_point m_locked{};
+        std::chrono::nanoseconds m_wait{0};
+    };
+
+    // The sequence is odd while the value is written
+    struct sequence_writer {
+        explicit sequence_writer(std::atomic<std::uint64_t> &sequence) noexcept : sequence{sequence} {
+            sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+        ~sequence_writer() { sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+        std::atomic<std::uint64_t> &sequence;
+    };
+
   public:
     template <typename F>
     /**
      * @brief with_lock Lock as a mutable reference
+     *
+     * With the seqlock policy, f is given a copy of the value, that is stored back after the call, and the result must
+     * not refer to it.
      */
     decltype(auto) with_lock(F &&f) {
-        std::lock_guard lock{m_mutex};
-        return ltl::invoke(FWD(f), m_value);
+        guard<false> lock{*this};
+        if constexpr (is_seqlock) {
+            // f modifies a copy, and the readers only start again while it is stored back
+            struct publisher {
+                explicit publisher(mutex &owner) noexcept : owner{owner} { owner.load(copy); }
+                ~publisher() {
+                    sequence_writer writer{owner.m_sequence};
+                    owner.store(copy);
+                }
+                mutex &owner;
+                typename mutex::snapshot copy;
+            } publish{*this};
+            return ltl::invoke(FWD(f), publish.copy.value());
+        } else {
+            return ltl::invoke(FWD(f), this->m_value);
+        }
     }
 
     template <typename F>
     /**
      * @brief with_lock lock as a const reference
+     *
+     * With the seqlock policy, f is given a copy of the value, and the result must not refer to it.
      */
     decltype(auto) with_lock(F &&f) const {
-        std::shared_lock lock{m_mutex};
-        return ltl::invoke(FWD(f), m_value);
+        if constexpr (is_seqlock) {
+            return read_sequence(FWD(f));
+        } else {
+            guard<is_shared> lock{*this};
+            return ltl::invoke(FWD(f), this->m_value);
+        }
+    }
+
+    /**
+     * @brief telemetry - The measures of this mutex, if it is instrumented
+     */
+    const Telemetry &telemetry() const noexcept { return this->get_telemetry(); }
+    Telemetry &telemetry() noexcept { return this->get_telemetry(); }
+
+  private:
+    static clock::time_point now() noexcept {
+        if constexpr (Telemetry::enabled)
+            return clock::now();
+        else
+            return {};
+    }
+
+    template <typename F>
+    decltype(auto) read_sequence(F &&f) const {
+        [[maybe_unused]] const auto start = now();
+        bool contended = false;
+        typename mutex::snapshot storage;
+        while (true) {
+            const auto before = this->m_sequence.load(std::memory_order_acquire);
+            if (before % 2 == 0) {
+                this->load(storage);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (this->m_sequence.load(std::memory_order_relaxed) == before)
+                    break;
+            }
+            contended = true;
+            details::cpu_relax();
+        }
+        const T &copy = storage.value();
+
+        if constexpr (Telemetry::enabled) {
+            // The copy is the waiting time, the call of f is the holding time
+            struct recorder {
+                ~recorder() { telemetry.record(contended, read - start, clock::now() - read); }
+                Telemetry &telemetry;
+                bool contended;
+                clock::time_point start, read;
+            } record{this->get_telemetry(), contended, start, clock::now()};
+            return ltl::invoke(FWD(f), copy);
+        } else {
+            (void)contended;
+            return ltl::invoke(FWD(f), copy);
+        }
     }
 
   protected:
-    T m_value;
-    mutable std::shared_mutex m_mutex;
+    mutable typename Policy::mutex_type m_mutex;
+};
+
+/// \cond
+namespace details {
+/**
+ * Chase-Lev work stealing deque (Lê, Pop, Cohen, Zappa Nardelli, "Correct and efficient work-stealing for weak memory
+ * models"). The owner pushes and pops at the bottom, other threads steal from the top.
+ */
+template <typename T>
+class work_stealing_deque {
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+
+    struct array {
+        explicit array(std::int64_t capacity) :
+            capacity{capacity}, mask{capacity - 1}, buffer{std::make_unique<std::atomic<T>[]>(capacity)} {}
+
+        T get(std::int64_t i) const noexcept { return buffer[i & mask].load(std::memory_order_relaxed); }
+        void put(std::int64_t i, T x) noexcept { buffer[i & mask].store(x, std::memory_order_relaxed); }
+
+        std::int64_t capacity;
+        std::int64_t mask;
+        std::unique_ptr<std::atomic<T>[]> buffer;
+    };
+
+  public:
+    explicit work_stealing_deque(std::int64_t capacity = 256) {
+        m_arrays.push_back(std::make_unique<array>(capacity));
+        m_array.store(m_arrays.back().get(), std::memory_order_relaxed);
+    }
+
+    void push(T x) {
+        std::int64_t b = m_bottom.load(std::memory_order_relaxed);
+        std::int64_t t = m_top.load(std::memory_order_acquire);
+        array *a = m_array.load(std::memory_order_relaxed);
+        if (b - t > a->capacity - 1)
+            a = grow(a, b, t);
+        a->put(b, x);
+        m_bottom.store(b + 1, std::memory_order_release);
+    }
+
+    std::optional<T> pop() noexcept {
+        std::int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+        array *a = m_array.load(std::memory_order_relaxed);
+        m_bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = m_top.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+
+        std::optional<T> x = a->get(b);
+        if (t == b) {
+            if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                x.reset();
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return x;
+    }
+
+    std::optional<T> steal() noexcept {
+        std::int64_t t = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t b = m_bottom.load(std::memory_order_acquire);
+
+        if (t >= b)
+            return std::nullopt;
+
+        T x = m_array.load(std::memory_order_acquire)->get(t);
+        if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return std::nullopt;
+        return x;
+    }
+
+  private:
+    array *grow(array *old, std::int64_t bottom, std::int64_t top) {
+        auto a = std::make_unique<array>(old->capacity * 2);
+        for (std::int64_t i = top; i < bottom; ++i)
+            a->put(i, old->get(i));
+        // Thieves may still read from the old array: it is released with the deque
+        m_arrays.push_back(std::move(a));
+        m_array.store(m_arrays.back().get(), std::memory_order_release);
+        return m_arrays.back().get();
+    }
+
+    alignas(64) std::atomic<std::int64_t> m_top{0};
+    alignas(64) std::atomic<std::int64_t> m_bottom{0};
+    std::atomic<array *> m_array;
+    std::vector<std::unique_ptr<array>> m_arrays;
 };
+} // namespace details
+/// \endcond
+
+/**
+ * @brief The thread_pool class
+ *
+ * A fixed set of workers, each one owning a work stealing deque.
+ * Tasks submitted from a worker go to its own deque, the other ones go to a shared queue. An idle worker steals tasks
+ * from the shared queue, then from the other workers.
+ *
+ * @code
+ *  ltl::thread_pool pool{4};
+ *  std::future<int> result = pool.submit([] { return 42; });
+ *  use(pool.get(result));
+ *
+ *  pool.parallel_for(values, [](auto &value) { value *= 2; });
+ * @endcode
+ *
+ * If coroutines are enabled, `co_await pool.schedule()` resumes the coroutine on one of the workers.
+ */
+class thread_pool {
+    // A task is allocated once, with the callable it runs
+    struct task {
+        virtual ~task() = default;
+        virtual void operator()() = 0;
+    };
+
+    template <typename F>
+    struct task_of final : task {
+        explicit task_of(F f) : f{std::move(f)} {}
+        void operator()() override { f(); }
+        F f;
+    };
+
+    template <typename F>
+    static task *make_task(F f) {
+        return new task_of<F>{std::move(f)};
+    }
+
+    struct worker_slot {
+        const thread_pool *pool = nullptr;
+        std::size_t index = 0;
+    };
+
+    static worker_slot &current_worker() noexcept {
+        thread_local worker_slot slot;
+        return slot;
+    }
+
+  public:
+    explicit thread_pool(std::size_t threadCount = std::thread::hardware_concurrency()) :
+        m_deques(std::max<std::size_t>(threadCount, 1)) {
+        m_threads.reserve(m_deques.size());
+        for (std::size_t i = 0; i < m_deques.size(); ++i)
+            m_threads.emplace_back([this, i] { run(i); });
+    }
+
+    thread_pool(const thread_pool &) = delete;
+    thread_pool &operator=(const thread_pool &) = delete;
+
+    ~thread_pool() {
+        {
+            std::lock_guard lock{m_mutex};
+            m_stopping = true;
+        }
+        m_condition.notify_all();
+        for (auto &thread : m_threads)
+            thread.join();
+    }
+
+    /**
+     * @brief size - returns the number of workers
+     */
+    std::size_t size() const noexcept { return m_threads.size(); }
+
+    template <typename F>
+    /**
+     * @brief submit - schedule f on one of the workers
+     *
+     * The returned future carries either the result of f or the exception it threw.
+     */
+    auto submit(F f) {
+        using result_type = std::invoke_result_t<F &>;
+        std::packaged_task<result_type()> packaged{std::move(f)};
+        auto future = packaged.get_future();
+        push(make_task(std::move(packaged)));
+        return future;
+    }
+
+    template <typename T>
+    /**
+     * @brief get - Same as future.get(), but the calling thread runs pending tasks while waiting
+     *
+     * It must be used instead of future.get() from a task, else the workers may all end up waiting each other.
+     */
+    T get(std::future<T> &future) {
+        wait(future);
+        return future.get();
+    }
+
+    template <typename T>
+    /**
+     * @brief wait - Same as future.wait(), but the calling thread runs pending tasks while waiting
+     *
+     * Once there is nothing left to run, the awaited task is running on another thread, and the caller sleeps until
+     * it is done instead of competing with the workers.
+     */
+    void wait(const std::future<T> &future) {
+        while (future.wait_for(std::chrono::seconds{0}) != std::future_status::ready) {
+            if (!run_pending_task()) {
+                future.wait();
+                return;
+            }
+        }
+    }
+
+    template <typename T>
+    /**
+     * @brief wait_all - Waits for every future, without rethrowing their exceptions
+     *
+     * It must be called before propagating an exception when the tasks reference objects of the caller, so that none of
+     * them is still running once these objects are destroyed.
+     */
+    void wait_all(const std::vector<std::future<T>> &futures) {
+        for (const auto &future : futures)
+            wait(future);
+    }
+
+    template <typename R, typename F>
+    /**
+     * @brief parallel_for - call f on each element of the range, the calls are spread over the workers
+     *
+     * Random access ranges are split without walking them, other ones are walked once to find the chunk bounds.
+     * The first exception thrown by f is rethrown once every chunk is done.
+     */
+    void parallel_for(R &&range, F f) {
+        using std::begin;
+        using std::end;
+        auto first = begin(range);
+        auto last = end(range);
+        using It = decltype(first);
+
+        const std::size_t n = std::distance(first, last);
+        const std::size_t chunkCount = std::max<std::size_t>(1, std::min(n, size() * chunks_per_thread));
+
+        std::vector<It> bounds;
+        bounds.reserve(chunkCount + 1);
+        bounds.push_back(first);
+        for (std::size_t i = 1; i < chunkCount; ++i)
+            bounds.push_back(std::next(bounds.back(), n * i / chunkCount - n * (i - 1) / chunkCount));
+        bounds.push_back(last);
+
+        std::vector<std::future<void>> futures;
+        futures.reserve(chunkCount);
+        for (std::size_t i = 0; i < chunkCount; ++i) {
+            futures.push_back(submit([&f, b = bounds[i], e = bounds[i + 1]]() mutable {
+                for (; b != e; ++b)
+                    ltl::invoke(f, *b);
+            }));
+        }
+
+        wait_all(futures);
+        for (auto &future : futures)
+            get(future);
+    }
+
+#if LTL_COROUTINE
+    struct schedule_awaiter {
+        thread_pool *pool;
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) {
+            pool->push(make_task([handle] { handle.resume(); }));
+        }
+        void await_resume() const noexcept {}
+    };
+
+    /**
+     * @brief schedule - returns an awaitable resuming the coroutine on one of the workers
+     */
+    schedule_awaiter schedule() noexcept { return {this}; }
+#endif
+
+    static constexpr std::size_t chunks_per_thread = 4;
+
+  private:
+    void push(task *t) {
+        worker_slot &slot = current_worker();
+        if (slot.pool == this) {
+            m_deques[slot.index].push(t);
+        } else {
+            std::lock_guard lock{m_injectionMutex};
+            m_injection.push_back(t);
+        }
+
+        // A worker counts itself as sleeping before testing m_pending under m_mutex: either it sees this task, or it
+        // is seen here, and locking m_mutex makes sure it does not miss the notification
+        m_pending.fetch_add(1, std::memory_order_seq_cst);
+        if (m_sleeping.load(std::memory_order_seq_cst) == 0)
+            return;
+        {
+            std::lock_guard lock{m_mutex};
+        }
+        m_condition.notify_one();
+    }
+
+    task *take_task() noexcept {
+        worker_slot &slot = current_worker();
+        const bool isWorker = slot.pool == this;
+
+        if (isWorker) {
+            if (auto t = m_deques[slot.index].pop())
+                return *t;
+        }
+
+        {
+            std::lock_guard lock{m_injectionMutex};
+            if (!m_injection.empty()) {
+                task *t = m_injection.front();
+                m_injection.pop_front();
+                return t;
+            }
+        }
+
+        const std::size_t start = isWorker ? slot.index + 1 : 0;
+        for (std::size_t i = 0; i < m_deques.size(); ++i) {
+            if (auto t = m_deques[(start + i) % m_deques.size()].steal())
+                return *t;
+        }
+        return nullptr;
+    }
+
+    bool run_pending_task() {
+        std::unique_ptr<task> t{take_task()};
+        if (!t)
+            return false;
+        m_pending.fetch_sub(1, std::memory_order_relaxed);
+        (*t)();
+        return true;
+    }
+
+    void run(std::size_t index) {
+        current_worker() = worker_slot{this, index};
+        while (true) {
+            if (run_pending_task())
+                continue;
+
+            std::unique_lock lock{m_mutex};
+            m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+            m_condition.wait(lock, [this] { return m_stopping || m_pending.load(std::memory_order_seq_cst) > 0; });
+            m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+            if (m_stopping && m_pending.load(std::memory_order_acquire) == 0)
+                return;
+        }
+    }
+
+    std::vector<details::work_stealing_deque<task *>> m_deques;
+    std::deque<task *> m_injection;
+    std::mutex m_injectionMutex;
+    std::vector<std::thread> m_threads;
+
+    std::atomic<std::size_t> m_pending{0};
+    std::atomic<std::size_t> m_sleeping{0};
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_stopping = false;
+};
+
+/**
+ * @brief default_thread_pool - The pool used when no other one is given, one worker per hardware thread
+ */
+inline thread_pool &default_thread_pool() {
+    static thread_pool pool;
+    return pool;
+}
+
+template <typename R, typename F>
+/**
+ * @brief parallel_for - call f on each element of the range using the default thread pool
+ *
+ * @code
+ *  std::vector<Image> images;
+ *  ltl::parallel_for(images, [](Image &image) { blur(image); });
+ *  ltl::parallel_for(images | ltl::filter(isLarge), [](Image &image) { blur(image); });
+ * @endcode
+ */
+void parallel_for(R &&range, F f) {
+    default_thread_pool().parallel_for(FWD(range), std::move(f));
+}
 
 /// @}
 